@@ -0,0 +1,233 @@
+#include "cpu-culling.hpp"
+
+#include "frustum.hpp"
+#include "instanced-quads.hpp"
+#include "job-system.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define CPU_CULLING_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)                                     \
+  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPU_CULLING_SSE
+#include <emmintrin.h>
+#endif
+
+// instances per culling job, a multiple of every simd width
+constexpr size_t g_cull_chunk_size = 16 * 1024;
+
+cull_bounds_t cull_bounds_from_quads(
+  job_system_t& job_system, const std::vector<quad_instance_t>& quads)
+{
+  cull_bounds_t bounds;
+  bounds.x.resize(quads.size());
+  bounds.y.resize(quads.size());
+  bounds.z.resize(quads.size());
+  bounds.radius.resize(quads.size());
+  parallel_for(
+    job_system, static_cast<int64_t>(quads.size()), g_cull_chunk_size,
+    [&bounds, &quads](const int64_t begin, const int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        const bounding_sphere_t sphere = quad_bounding_sphere(quads[i].model);
+        bounds.x[i] = sphere.x;
+        bounds.y[i] = sphere.y;
+        bounds.z[i] = sphere.z;
+        bounds.radius[i] = sphere.radius;
+      }
+    });
+  return bounds;
+}
+
+static bool sphere_visible(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  const size_t index)
+{
+  for (const auto& plane : frustum.planes) {
+    const float distance = plane[0] * bounds.x[index]
+                         + plane[1] * bounds.y[index]
+                         + plane[2] * bounds.z[index] + plane[3];
+    if (distance < -bounds.radius[index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// tests [begin, end) and appends to visible starting at count
+static size_t cull_spheres_range_scalar(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  const size_t begin, const size_t end, uint32_t* visible, size_t count)
+{
+  for (size_t i = begin; i < end; ++i) {
+    visible[count] = static_cast<uint32_t>(i);
+    count += sphere_visible(bounds, frustum, i) ? 1 : 0;
+  }
+  return count;
+}
+
+void cull_spheres_scalar(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  std::vector<uint32_t>& visible)
+{
+  const size_t instance_count = bounds.x.size();
+  visible.resize(instance_count);
+  visible.resize(cull_spheres_range_scalar(
+    bounds, frustum, 0, instance_count, visible.data(), 0));
+}
+
+void cull_spheres(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  std::vector<uint32_t>& visible)
+{
+  const size_t instance_count = bounds.x.size();
+  visible.resize(instance_count);
+  visible.resize(
+    cull_spheres_range(bounds, frustum, 0, instance_count, visible.data()));
+}
+
+void cull_spheres_parallel(
+  job_system_t& job_system, const cull_bounds_t& bounds,
+  const frustum_planes_t& frustum, std::vector<uint32_t>& visible)
+{
+  const size_t instance_count = bounds.x.size();
+  const size_t chunk_count =
+    (instance_count + g_cull_chunk_size - 1) / g_cull_chunk_size;
+  visible.resize(instance_count);
+  std::vector<size_t> chunk_visible_counts(chunk_count);
+  parallel_for(
+    job_system, static_cast<int64_t>(chunk_count), 1,
+    [&](const int64_t begin, const int64_t end) {
+      for (int64_t chunk = begin; chunk < end; ++chunk) {
+        const size_t first = chunk * g_cull_chunk_size;
+        chunk_visible_counts[chunk] = cull_spheres_range(
+          bounds, frustum, first,
+          std::min(first + g_cull_chunk_size, instance_count),
+          visible.data());
+      }
+    });
+
+  // each chunk compacted into its own part of visible, close the gaps
+  size_t count = 0;
+  for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    const auto first = visible.begin() + chunk * g_cull_chunk_size;
+    std::copy(
+      first, first + chunk_visible_counts[chunk], visible.begin() + count);
+    count += chunk_visible_counts[chunk];
+  }
+  visible.resize(count);
+}
+
+#if defined(CPU_CULLING_AVX2)
+
+size_t cull_spheres_range(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  const size_t begin, const size_t end, uint32_t* const visible)
+{
+  __m256 planes[6][4];
+  for (int p = 0; p < 6; ++p) {
+    for (int c = 0; c < 4; ++c) {
+      planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+    }
+  }
+
+  size_t count = begin;
+  const size_t simd_end = end - (end - begin) % 8;
+  for (size_t i = begin; i < simd_end; i += 8) {
+    const __m256 x = _mm256_loadu_ps(&bounds.x[i]);
+    const __m256 y = _mm256_loadu_ps(&bounds.y[i]);
+    const __m256 z = _mm256_loadu_ps(&bounds.z[i]);
+    const __m256 neg_radius =
+      _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&bounds.radius[i]));
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (const auto& plane : planes) {
+      const __m256 distance = _mm256_add_ps(
+        _mm256_add_ps(
+          _mm256_mul_ps(plane[0], x), _mm256_mul_ps(plane[1], y)),
+        _mm256_add_ps(_mm256_mul_ps(plane[2], z), plane[3]));
+      inside =
+        _mm256_and_ps(inside, _mm256_cmp_ps(distance, neg_radius, _CMP_GE_OQ));
+    }
+    // branchless compaction, every lane is written but only visible ones
+    // advance the output position
+    const int mask = _mm256_movemask_ps(inside);
+    for (int lane = 0; lane < 8; ++lane) {
+      visible[count] = static_cast<uint32_t>(i + lane);
+      count += (mask >> lane) & 1;
+    }
+  }
+
+  return cull_spheres_range_scalar(
+           bounds, frustum, simd_end, end, visible, count)
+       - begin;
+}
+
+const char* cull_spheres_implementation()
+{
+  return "AVX2";
+}
+
+#elif defined(CPU_CULLING_SSE)
+
+size_t cull_spheres_range(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  const size_t begin, const size_t end, uint32_t* const visible)
+{
+  __m128 planes[6][4];
+  for (int p = 0; p < 6; ++p) {
+    for (int c = 0; c < 4; ++c) {
+      planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+    }
+  }
+
+  size_t count = begin;
+  const size_t simd_end = end - (end - begin) % 4;
+  for (size_t i = begin; i < simd_end; i += 4) {
+    const __m128 x = _mm_loadu_ps(&bounds.x[i]);
+    const __m128 y = _mm_loadu_ps(&bounds.y[i]);
+    const __m128 z = _mm_loadu_ps(&bounds.z[i]);
+    const __m128 neg_radius =
+      _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&bounds.radius[i]));
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const auto& plane : planes) {
+      const __m128 distance = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)),
+        _mm_add_ps(_mm_mul_ps(plane[2], z), plane[3]));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, neg_radius));
+    }
+    // branchless compaction, every lane is written but only visible ones
+    // advance the output position
+    const int mask = _mm_movemask_ps(inside);
+    for (int lane = 0; lane < 4; ++lane) {
+      visible[count] = static_cast<uint32_t>(i + lane);
+      count += (mask >> lane) & 1;
+    }
+  }
+
+  return cull_spheres_range_scalar(
+           bounds, frustum, simd_end, end, visible, count)
+       - begin;
+}
+
+const char* cull_spheres_implementation()
+{
+  return "SSE";
+}
+
+#else
+
+size_t cull_spheres_range(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  const size_t begin, const size_t end, uint32_t* const visible)
+{
+  return cull_spheres_range_scalar(bounds, frustum, begin, end, visible, begin)
+       - begin;
+}
+
+const char* cull_spheres_implementation()
+{
+  return "Scalar";
+}
+
+#endif
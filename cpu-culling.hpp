@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct frustum_planes_t;
+struct job_system_t;
+struct quad_instance_t;
+
+// instance bounding spheres stored as separate arrays so several can be
+// tested against a plane at once
+struct cull_bounds_t
+{
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> radius;
+};
+
+cull_bounds_t cull_bounds_from_quads(
+  job_system_t& job_system, const std::vector<quad_instance_t>& quads);
+
+// fills visible with the (ascending) indices of the spheres inside the frustum
+void cull_spheres(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  std::vector<uint32_t>& visible);
+
+// same result as cull_spheres, split into chunks run on the job system
+void cull_spheres_parallel(
+  job_system_t& job_system, const cull_bounds_t& bounds,
+  const frustum_planes_t& frustum, std::vector<uint32_t>& visible);
+
+// writes the indices of the visible spheres in [begin, end) to visible from
+// index begin on and returns how many there were, disjoint ranges of the
+// same array can be culled concurrently
+size_t cull_spheres_range(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum, size_t begin,
+  size_t end, uint32_t* visible);
+
+// reference implementation (always available, used for the remainder when the
+// count is not a multiple of the simd width)
+void cull_spheres_scalar(
+  const cull_bounds_t& bounds, const frustum_planes_t& frustum,
+  std::vector<uint32_t>& visible);
+
+// "AVX2", "SSE" or "Scalar" depending on what cull_spheres was built with
+const char* cull_spheres_implementation();
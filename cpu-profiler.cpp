@@ -0,0 +1,204 @@
+#include "cpu-profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// per thread, at ~10 zones a frame this holds close to a minute at 60hz
+constexpr uint64_t g_zone_ring_capacity = 1 << 15;
+
+// fields are atomic as the trace writer may read a slot while it's being
+// overwritten, torn slots are detected from the head and dropped
+struct zone_slot_t
+{
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> begin{0};
+  std::atomic<uint64_t> end{0};
+};
+
+struct zone_ring_t
+{
+  zone_slot_t slots[g_zone_ring_capacity];
+  std::atomic<uint64_t> head{0}; // zones written so far
+  // head plus the zone being written, lets readers spot overwritten slots
+  std::atomic<uint64_t> reserved{0};
+  std::atomic<const char*> thread_name{nullptr};
+  uint32_t thread_index = 0;
+};
+
+struct zone_t
+{
+  const char* name;
+  uint64_t begin;
+  uint64_t end;
+};
+
+// rings are only added (under the lock, once per thread) and never freed so
+// zones from threads that have exited still make it into traces, the ring of
+// an exited thread is handed to the next new thread so recreating threads
+// doesn't grow memory (its zones stay until the new owner laps them)
+static std::mutex g_zone_rings_mutex;
+static std::vector<std::unique_ptr<zone_ring_t>> g_zone_rings;
+static std::vector<zone_ring_t*> g_free_zone_rings;
+static thread_local zone_ring_t* t_zone_ring = nullptr;
+
+// puts the ring of the thread on the free list when the thread exits, kept
+// apart from t_zone_ring as recording only needs the plain pointer
+struct zone_ring_owner_t
+{
+  zone_ring_t* zone_ring = nullptr;
+  ~zone_ring_owner_t()
+  {
+    if (zone_ring != nullptr) {
+      std::lock_guard<std::mutex> lock(g_zone_rings_mutex);
+      g_free_zone_rings.push_back(zone_ring);
+    }
+  }
+};
+static thread_local zone_ring_owner_t t_zone_ring_owner;
+
+static zone_ring_t& thread_zone_ring()
+{
+  if (t_zone_ring == nullptr) {
+    std::lock_guard<std::mutex> lock(g_zone_rings_mutex);
+    if (g_free_zone_rings.empty()) {
+      auto zone_ring = std::make_unique<zone_ring_t>();
+      zone_ring->thread_index = static_cast<uint32_t>(g_zone_rings.size());
+      t_zone_ring = zone_ring.get();
+      g_zone_rings.push_back(std::move(zone_ring));
+    } else {
+      // the new owner shows up under the same thread index
+      t_zone_ring = g_free_zone_rings.back();
+      g_free_zone_rings.pop_back();
+      t_zone_ring->thread_name.store(nullptr, std::memory_order_relaxed);
+    }
+    t_zone_ring_owner.zone_ring = t_zone_ring;
+  }
+  return *t_zone_ring;
+}
+
+uint64_t cpu_profiler_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+void record_cpu_zone(const char* name, const uint64_t begin, const uint64_t end)
+{
+  zone_ring_t& zone_ring = thread_zone_ring();
+  const uint64_t head = zone_ring.head.load(std::memory_order_relaxed);
+  zone_slot_t& slot = zone_ring.slots[head % g_zone_ring_capacity];
+  zone_ring.reserved.store(head + 1, std::memory_order_relaxed);
+  // a reader that sees any of the slot writes also sees the reservation
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.begin.store(begin, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  zone_ring.head.store(head + 1, std::memory_order_release);
+}
+
+void set_cpu_profiler_thread_name(const char* name)
+{
+  thread_zone_ring().thread_name.store(name, std::memory_order_relaxed);
+}
+
+// copies the zones of ring that ended at or after since
+static std::vector<zone_t> copy_zones(
+  const zone_ring_t& zone_ring, const uint64_t since)
+{
+  const uint64_t head = zone_ring.head.load(std::memory_order_acquire);
+  const uint64_t first =
+    head > g_zone_ring_capacity ? head - g_zone_ring_capacity : 0;
+  std::vector<std::pair<uint64_t, zone_t>> copied;
+  for (uint64_t index = first; index < head; ++index) {
+    const zone_slot_t& slot = zone_ring.slots[index % g_zone_ring_capacity];
+    const zone_t zone{
+      slot.name.load(std::memory_order_relaxed),
+      slot.begin.load(std::memory_order_relaxed),
+      slot.end.load(std::memory_order_relaxed)};
+    if (zone.end >= since) {
+      copied.push_back({index, zone});
+    }
+  }
+
+  // anything the owning thread lapped (or started to) while copying may be
+  // torn, see record_cpu_zone
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t reserved =
+    zone_ring.reserved.load(std::memory_order_relaxed);
+  const uint64_t first_intact =
+    reserved > g_zone_ring_capacity ? reserved - g_zone_ring_capacity : 0;
+  std::vector<zone_t> zones;
+  zones.reserve(copied.size());
+  for (const auto& [index, zone] : copied) {
+    if (index >= first_intact) {
+      zones.push_back(zone);
+    }
+  }
+  return zones;
+}
+
+static void write_json_string(FILE* file, const char* string)
+{
+  std::fputc('"', file);
+  for (const char* c = string; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      std::fputc('\\', file);
+    }
+    std::fputc(*c, file);
+  }
+  std::fputc('"', file);
+}
+
+bool write_cpu_trace(const char* path, const double seconds)
+{
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  const uint64_t now = cpu_profiler_now();
+  const auto window = static_cast<uint64_t>(seconds * 1e9);
+  const uint64_t since = now > window ? now - window : 0;
+
+  std::vector<zone_ring_t*> zone_rings;
+  {
+    std::lock_guard<std::mutex> lock(g_zone_rings_mutex);
+    for (const auto& zone_ring : g_zone_rings) {
+      zone_rings.push_back(zone_ring.get());
+    }
+  }
+
+  // complete ("X") events in microseconds, plus thread name metadata
+  std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  bool first = true;
+  for (const zone_ring_t* zone_ring : zone_rings) {
+    if (const char* thread_name =
+          zone_ring->thread_name.load(std::memory_order_relaxed)) {
+      std::fprintf(
+        file,
+        "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+        "\"args\":{\"name\":",
+        first ? "" : ",", zone_ring->thread_index);
+      write_json_string(file, thread_name);
+      std::fprintf(file, "}}");
+      first = false;
+    }
+    for (const zone_t& zone : copy_zones(*zone_ring, since)) {
+      std::fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+      write_json_string(file, zone.name);
+      std::fprintf(
+        file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+        zone_ring->thread_index, double(zone.begin) / 1000.0,
+        double(zone.end - zone.begin) / 1000.0);
+      first = false;
+    }
+  }
+  std::fprintf(file, "\n]}\n");
+
+  return std::fclose(file) == 0;
+}
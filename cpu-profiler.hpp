@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+// scoped cpu zones recorded into a ring per thread, only the owning thread
+// writes to its ring so recording takes no locks, the trace writer copies
+// whatever hasn't been overwritten yet while threads keep recording
+// zone names must outlive the profiler (e.g. string literals)
+
+// nanoseconds on the steady clock
+uint64_t cpu_profiler_now();
+
+void record_cpu_zone(const char* name, uint64_t begin, uint64_t end);
+
+// names the calling thread in traces
+void set_cpu_profiler_thread_name(const char* name);
+
+// records the time from construction to destruction
+struct cpu_zone_t
+{
+  explicit cpu_zone_t(const char* name)
+    : name(name), begin(cpu_profiler_now())
+  {
+  }
+  ~cpu_zone_t() { record_cpu_zone(name, begin, cpu_profiler_now()); }
+  cpu_zone_t(const cpu_zone_t&) = delete;
+  cpu_zone_t& operator=(const cpu_zone_t&) = delete;
+
+  const char* name;
+  uint64_t begin;
+};
+
+// writes every zone that ended in the last seconds as chrome trace_event
+// json (opens in perfetto or chrome://tracing)
+bool write_cpu_trace(const char* path, double seconds);
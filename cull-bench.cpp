@@ -0,0 +1,108 @@
+// micro-benchmark for the cpu frustum culling, reports culled instances per
+// second for the scalar and simd implementations and how the parallel one
+// scales with the number of threads
+// usage: opengl-sdl-cull-bench [iterations]
+
+#include "cpu-culling.hpp"
+#include "frustum.hpp"
+#include "job-system.hpp"
+
+#include <as/as-view.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using cull_fn = void (*)(
+  const cull_bounds_t&, const frustum_planes_t&, std::vector<uint32_t>&);
+
+// returns the seconds per cull
+static double run(
+  const char* name, const cull_fn cull, const cull_bounds_t& bounds,
+  const frustum_planes_t& frustum, const int iterations)
+{
+  std::vector<uint32_t> visible;
+  cull(bounds, frustum, visible); // warm up
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    cull(bounds, frustum, visible);
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - begin).count();
+  const double instances = double(bounds.x.size()) * double(iterations);
+  printf(
+    "%-8s %8.3f ms/cull %10.1f M instances/s (%zu visible)\n", name,
+    seconds * 1000.0 / iterations, instances / seconds / 1e6, visible.size());
+  return seconds / iterations;
+}
+
+static void run_parallel(
+  const int32_t thread_count, const cull_bounds_t& bounds,
+  const frustum_planes_t& frustum, const int iterations,
+  const double single_thread_seconds)
+{
+  job_system_t job_system = create_job_system(thread_count - 1);
+  std::vector<uint32_t> visible;
+  cull_spheres_parallel(job_system, bounds, frustum, visible); // warm up
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    cull_spheres_parallel(job_system, bounds, frustum, visible);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  destroy_job_system(job_system);
+
+  const double seconds =
+    std::chrono::duration<double>(end - begin).count() / iterations;
+  printf(
+    "%2d threads %8.3f ms/cull %6.2fx speedup %5.1f%% efficiency\n",
+    thread_count, seconds * 1000.0, single_thread_seconds / seconds,
+    single_thread_seconds / seconds / thread_count * 100.0);
+}
+
+int main(int argc, char** argv)
+{
+  const int instance_count = 1'000'000;
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+
+  // spheres scattered around the camera (at the origin looking down -z)
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+  std::uniform_real_distribution<float> radius(0.5f, 5.0f);
+
+  cull_bounds_t bounds;
+  for (int i = 0; i < instance_count; ++i) {
+    bounds.x.push_back(position(generator));
+    bounds.y.push_back(position(generator));
+    bounds.z.push_back(position(generator));
+    bounds.radius.push_back(radius(generator));
+  }
+
+  const as::mat4 view_projection =
+    as::normalize_unit_range(as::perspective_opengl_rh(
+      as::radians(60.0f), 1024.0f / 768.0f, 0.1f, 1000.0f));
+  const frustum_planes_t frustum =
+    frustum_planes_from_view_projection(view_projection);
+
+  printf("%d instances, %d iterations\n", instance_count, iterations);
+  run("Scalar", cull_spheres_scalar, bounds, frustum, iterations);
+  const double single_thread_seconds = run(
+    cull_spheres_implementation(), cull_spheres, bounds, frustum, iterations);
+
+  // powers of two up to every hardware thread
+  const int32_t max_thread_count = default_job_worker_count() + 1;
+  for (int32_t thread_count = 1;; thread_count *= 2) {
+    thread_count = std::min(thread_count, max_thread_count);
+    run_parallel(
+      thread_count, bounds, frustum, iterations, single_thread_seconds);
+    if (thread_count == max_thread_count) {
+      break;
+    }
+  }
+
+  return 0;
+}
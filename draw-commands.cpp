@@ -0,0 +1,119 @@
+#include "draw-commands.hpp"
+
+#include "gl-state.hpp"
+#include "shader.hpp"
+
+#include <glad/gl.h>
+
+static_assert(
+  sizeof(draw_elements_indirect_command_t) == sizeof(uint32_t) * 5,
+  "draw_elements_indirect_command_t must be tightly packed");
+
+const char* const g_indirect_vertex_shader_source =
+  R"(#version 460 core
+layout (location = 0) in vec3 aPos;
+struct instance_t
+{
+  mat4 model;
+  vec4 color;
+};
+layout (std430, binding = 0) readonly buffer instances
+{
+  instance_t instance_data[];
+};
+layout (std140, binding = 2) uniform camera
+{
+  mat4 view_projection;
+};
+out vec4 Color;
+void main()
+{
+  // gl_InstanceID does not include the base instance of the draw command
+  const instance_t instance = instance_data[gl_BaseInstance + gl_InstanceID];
+  gl_Position = view_projection * instance.model * vec4(aPos, 1.0);
+  Color = instance.color;
+})";
+
+const char* const g_indirect_fragment_shader_source =
+  R"(#version 460 core
+out vec4 FragColor;
+in vec4 Color;
+void main()
+{
+  FragColor = Color;
+})";
+
+draw_commands_t create_draw_commands()
+{
+  draw_commands_t draw_commands;
+  draw_commands.program = create_shader(
+    g_indirect_vertex_shader_source, g_indirect_fragment_shader_source);
+  glGenBuffers(1, &draw_commands.command_buffer);
+  return draw_commands;
+}
+
+void destroy_draw_commands(draw_commands_t& draw_commands)
+{
+  gl_state_delete_buffers(1, &draw_commands.command_buffer);
+  destroy_shader(draw_commands.program);
+  draw_commands = draw_commands_t{};
+}
+
+void clear_draw_commands(draw_commands_t& draw_commands)
+{
+  draw_commands.commands.clear();
+}
+
+void record_draw_command(
+  draw_commands_t& draw_commands, const uint32_t index_count,
+  const uint32_t first_index, const int32_t base_vertex,
+  const uint32_t base_instance, const uint32_t instance_count)
+{
+  if (!draw_commands.commands.empty()) {
+    draw_elements_indirect_command_t& last = draw_commands.commands.back();
+    if (
+      last.count == index_count && last.first_index == first_index
+      && last.base_vertex == base_vertex
+      && last.base_instance + last.instance_count == base_instance) {
+      last.instance_count += instance_count;
+      return;
+    }
+  }
+
+  draw_commands.commands.push_back(draw_elements_indirect_command_t{
+    index_count, instance_count, first_index, base_vertex, base_instance});
+}
+
+void submit_draw_commands(
+  draw_commands_t& draw_commands, const uint32_t vao,
+  const uint32_t instance_buffer)
+{
+  if (draw_commands.commands.empty()) {
+    return;
+  }
+
+  const int64_t commands_size = static_cast<int64_t>(
+    draw_commands.commands.size() * sizeof(draw_elements_indirect_command_t));
+
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, draw_commands.command_buffer);
+  // orphan the previous contents when growing, otherwise overwrite in place
+  if (commands_size > draw_commands.command_buffer_size) {
+    glBufferData(
+      GL_DRAW_INDIRECT_BUFFER, commands_size, draw_commands.commands.data(),
+      GL_STREAM_DRAW);
+    draw_commands.command_buffer_size = commands_size;
+  } else {
+    glBufferSubData(
+      GL_DRAW_INDIRECT_BUFFER, 0, commands_size,
+      draw_commands.commands.data());
+  }
+
+  gl_state_use_program(draw_commands.program.id);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instance_buffer);
+  gl_state_bind_vertex_array(vao);
+  glMultiDrawElementsIndirect(
+    GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+    static_cast<GLsizei>(draw_commands.commands.size()), 0);
+
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
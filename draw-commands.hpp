@@ -0,0 +1,43 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// matches the layout glMultiDrawElementsIndirect reads from the indirect
+// buffer
+struct draw_elements_indirect_command_t
+{
+  uint32_t count;
+  uint32_t instance_count;
+  uint32_t first_index;
+  int32_t base_vertex;
+  uint32_t base_instance;
+};
+
+// records indirect draw commands and submits the whole frame with a single
+// glMultiDrawElementsIndirect call, per-instance data is read in the shader
+// from a storage buffer using gl_BaseInstance and the view projection from
+// the camera uniform block (binding 2)
+struct draw_commands_t
+{
+  shader_program_t program;
+  uint32_t command_buffer = 0;
+  int64_t command_buffer_size = 0;
+  std::vector<draw_elements_indirect_command_t> commands;
+};
+
+draw_commands_t create_draw_commands();
+void destroy_draw_commands(draw_commands_t& draw_commands);
+
+void clear_draw_commands(draw_commands_t& draw_commands);
+
+// adjacent draws of the same mesh with consecutive instances are merged
+void record_draw_command(
+  draw_commands_t& draw_commands, uint32_t index_count, uint32_t first_index,
+  int32_t base_vertex, uint32_t base_instance, uint32_t instance_count = 1);
+
+// instance_buffer holds an array of quad_instance_t (see instanced-quads.hpp)
+void submit_draw_commands(
+  draw_commands_t& draw_commands, uint32_t vao, uint32_t instance_buffer);
@@ -0,0 +1,124 @@
+#include "frame-bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+static float percentile(
+  const std::vector<float>& sorted_frame_times, const float fraction)
+{
+  const auto count = static_cast<int64_t>(sorted_frame_times.size());
+  const auto rank =
+    static_cast<int64_t>(std::ceil(fraction * static_cast<float>(count)));
+  return sorted_frame_times[std::clamp(rank - 1, int64_t(0), count - 1)];
+}
+
+frame_time_stats_t frame_time_stats(std::vector<float>& frame_times)
+{
+  if (frame_times.empty()) {
+    return {};
+  }
+
+  std::sort(frame_times.begin(), frame_times.end());
+  // accumulated in double, a long run of small floats drifts otherwise
+  const double total =
+    std::accumulate(frame_times.begin(), frame_times.end(), 0.0);
+
+  frame_time_stats_t stats;
+  stats.mean = static_cast<float>(total / double(frame_times.size()));
+  stats.p50 = percentile(frame_times, 0.50f);
+  stats.p95 = percentile(frame_times, 0.95f);
+  stats.p99 = percentile(frame_times, 0.99f);
+  stats.max = frame_times.back();
+  return stats;
+}
+
+void print_frame_bench_results(
+  const std::vector<frame_bench_result_t>& results)
+{
+  printf(
+    "%-9s %-8s %-6s %8s %8s %8s %8s %8s %8s %8s\n", "layout", "depth",
+    "render", "mean ms", "p50 ms", "p95 ms", "p99 ms", "max ms", "gpu mean",
+    "gpu p99");
+  for (const frame_bench_result_t& result : results) {
+    printf(
+      "%-9s %-8s %-6s %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f\n",
+      result.layout_mode, result.depth_mode, result.render_mode,
+      result.cpu.mean, result.cpu.p50, result.cpu.p95, result.cpu.p99,
+      result.cpu.max, result.gpu.mean, result.gpu.p99);
+  }
+}
+
+static void write_stats_csv(FILE* file, const frame_time_stats_t& stats)
+{
+  std::fprintf(
+    file, ",%.4f,%.4f,%.4f,%.4f,%.4f", stats.mean, stats.p50, stats.p95,
+    stats.p99, stats.max);
+}
+
+bool write_frame_bench_csv(
+  const std::vector<frame_bench_result_t>& results, const char* path)
+{
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::fprintf(file, "layout_mode,depth_mode,render_mode,frames");
+  for (const char* source : {"cpu", "gpu"}) {
+    for (const char* stat : {"mean", "p50", "p95", "p99", "max"}) {
+      std::fprintf(file, ",%s_%s_ms", source, stat);
+    }
+  }
+  std::fprintf(file, "\n");
+
+  for (const frame_bench_result_t& result : results) {
+    std::fprintf(
+      file, "%s,%s,%s,%d", result.layout_mode, result.depth_mode,
+      result.render_mode, result.frame_count);
+    write_stats_csv(file, result.cpu);
+    write_stats_csv(file, result.gpu);
+    std::fprintf(file, "\n");
+  }
+
+  return std::fclose(file) == 0;
+}
+
+static void write_stats_json(
+  FILE* file, const char* name, const frame_time_stats_t& stats)
+{
+  std::fprintf(
+    file,
+    "\"%s\": {\"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, "
+    "\"p99_ms\": %.4f, \"max_ms\": %.4f}",
+    name, stats.mean, stats.p50, stats.p95, stats.p99, stats.max);
+}
+
+bool write_frame_bench_json(
+  const std::vector<frame_bench_result_t>& results, const char* path)
+{
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // names are plain identifiers so nothing needs escaping
+  std::fprintf(file, "[\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const frame_bench_result_t& result = results[i];
+    std::fprintf(
+      file,
+      "  {\"layout_mode\": \"%s\", \"depth_mode\": \"%s\", "
+      "\"render_mode\": \"%s\", \"frames\": %d,\n   ",
+      result.layout_mode, result.depth_mode, result.render_mode,
+      result.frame_count);
+    write_stats_json(file, "cpu", result.cpu);
+    std::fprintf(file, ",\n   ");
+    write_stats_json(file, "gpu", result.gpu);
+    std::fprintf(file, "}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "]\n");
+
+  return std::fclose(file) == 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// summary of a run of frame times, all in milliseconds
+struct frame_time_stats_t
+{
+  float mean = 0.0f;
+  float p50 = 0.0f;
+  float p95 = 0.0f;
+  float p99 = 0.0f;
+  float max = 0.0f;
+};
+
+// one combination of modes run for frame_count timed frames
+struct frame_bench_result_t
+{
+  const char* layout_mode = nullptr; // names must outlive the result
+  const char* depth_mode = nullptr;
+  const char* render_mode = nullptr;
+  int32_t frame_count = 0;
+  frame_time_stats_t cpu; // wall clock from the start of a frame to the next
+  frame_time_stats_t gpu; // scene and present passes
+};
+
+// nearest rank percentiles, sorts frame_times (ms) in place
+frame_time_stats_t frame_time_stats(std::vector<float>& frame_times);
+
+void print_frame_bench_results(
+  const std::vector<frame_bench_result_t>& results);
+
+// a row per result with flattened stats columns
+bool write_frame_bench_csv(
+  const std::vector<frame_bench_result_t>& results, const char* path);
+// an array with an object per result
+bool write_frame_bench_json(
+  const std::vector<frame_bench_result_t>& results, const char* path);
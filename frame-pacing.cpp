@@ -0,0 +1,143 @@
+#include "frame-pacing.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+const char* pacing_mode_name(const pacing_mode_e mode)
+{
+  switch (mode) {
+    case pacing_mode_e::vsync:
+      return "vsync";
+    case pacing_mode_e::adaptive_vsync:
+      return "adaptive vsync";
+    case pacing_mode_e::uncapped:
+      return "uncapped";
+    case pacing_mode_e::limited:
+      return "limited";
+    case pacing_mode_e::count:
+      break;
+  }
+  return "unknown";
+}
+
+frame_pacer_t create_frame_pacer(
+  const pacing_mode_e mode, const int32_t history_size)
+{
+  frame_pacer_t frame_pacer;
+  frame_pacer.history.resize(history_size, 0.0f);
+  set_frame_pacing_mode(frame_pacer, mode);
+  return frame_pacer;
+}
+
+void set_frame_pacing_mode(
+  frame_pacer_t& frame_pacer, const pacing_mode_e mode)
+{
+  frame_pacer.mode = mode;
+  frame_pacer.adaptive_fallback = false;
+  switch (mode) {
+    case pacing_mode_e::vsync:
+      SDL_GL_SetSwapInterval(1);
+      break;
+    case pacing_mode_e::adaptive_vsync:
+      // needs EXT_swap_control_tear (or the platform equivalent)
+      if (SDL_GL_SetSwapInterval(-1) != 0) {
+        SDL_GL_SetSwapInterval(1);
+        frame_pacer.adaptive_fallback = true;
+      }
+      break;
+    case pacing_mode_e::uncapped:
+    case pacing_mode_e::limited:
+    case pacing_mode_e::count:
+      SDL_GL_SetSwapInterval(0);
+      break;
+  }
+  // don't rush to catch up on time spent in another mode
+  frame_pacer.deadline = std::chrono::steady_clock::time_point{};
+}
+
+static void update_statistics(frame_pacer_t& frame_pacer)
+{
+  const auto size = static_cast<int32_t>(frame_pacer.history.size());
+  const int32_t count = frame_pacer.history_count;
+  // oldest first
+  const auto frame_time = [&frame_pacer, size, count](const int32_t i) {
+    return frame_pacer
+      .history[(frame_pacer.history_offset + size - count + i) % size];
+  };
+
+  double total = 0.0;
+  float max = 0.0f;
+  for (int32_t i = 0; i < count; ++i) {
+    total += frame_time(i);
+    max = std::max(max, frame_time(i));
+  }
+  const double mean = total / double(count);
+
+  double variance = 0.0;
+  double change = 0.0;
+  for (int32_t i = 0; i < count; ++i) {
+    variance += (frame_time(i) - mean) * (frame_time(i) - mean);
+    if (i > 0) {
+      change += std::abs(frame_time(i) - frame_time(i - 1));
+    }
+  }
+
+  frame_pacer.mean = static_cast<float>(mean);
+  frame_pacer.jitter = static_cast<float>(std::sqrt(variance / double(count)));
+  frame_pacer.frame_to_frame =
+    count > 1 ? static_cast<float>(change / double(count - 1)) : 0.0f;
+  frame_pacer.max = max;
+}
+
+float begin_frame_pacer_frame(frame_pacer_t& frame_pacer)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto previous = frame_pacer.frame_begin;
+  frame_pacer.frame_begin = now;
+  if (previous == std::chrono::steady_clock::time_point{}) {
+    return 0.0f;
+  }
+
+  const float delta_time = std::chrono::duration<float>(now - previous).count();
+  const auto size = static_cast<int32_t>(frame_pacer.history.size());
+  if (size > 0) {
+    frame_pacer.history[frame_pacer.history_offset] = delta_time * 1000.0f;
+    frame_pacer.history_offset = (frame_pacer.history_offset + 1) % size;
+    frame_pacer.history_count = std::min(frame_pacer.history_count + 1, size);
+    update_statistics(frame_pacer);
+  }
+  return delta_time;
+}
+
+void wait_frame_pacer(frame_pacer_t& frame_pacer)
+{
+  frame_pacer.wait_time = 0.0f;
+  if (frame_pacer.mode != pacing_mode_e::limited) {
+    return;
+  }
+
+  const auto period =
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(
+        1.0 / std::max(double(frame_pacer.target_rate), 1.0)));
+  const auto begin = std::chrono::steady_clock::now();
+  if (begin > frame_pacer.deadline + period) {
+    // more than a frame behind (or the first frame), start over from now
+    // instead of running a burst of frames back to back to catch up
+    frame_pacer.deadline = begin;
+  } else {
+    if (frame_pacer.deadline - begin > frame_pacer.spin_margin) {
+      std::this_thread::sleep_until(
+        frame_pacer.deadline - frame_pacer.spin_margin);
+    }
+    while (std::chrono::steady_clock::now() < frame_pacer.deadline) {
+    }
+    frame_pacer.wait_time = std::chrono::duration<float>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+  }
+  frame_pacer.deadline += period;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+enum class pacing_mode_e
+{
+  vsync,
+  adaptive_vsync, // late frames swap immediately (tears) instead of waiting
+  uncapped,
+  limited, // vsync off, frames started at a fixed rate
+  count
+};
+
+// owns the swap interval and the frame clock, delta times come from a
+// monotonic clock and the spread of recent frame times is kept as jitter
+struct frame_pacer_t
+{
+  pacing_mode_e mode = pacing_mode_e::vsync;
+  bool adaptive_fallback = false; // adaptive vsync unsupported, using vsync
+  float target_rate = 60.0f; // hz, limited mode
+  // the limiter sleeps until this long before the deadline then spins, os
+  // sleeps can overshoot by around a scheduler tick
+  std::chrono::steady_clock::duration spin_margin =
+    std::chrono::microseconds(2000);
+  std::chrono::steady_clock::time_point deadline; // of the limited frame
+  std::chrono::steady_clock::time_point frame_begin;
+  float wait_time = 0.0f; // seconds spent in the limiter last frame
+  std::vector<float> history; // frame times in ms
+  int32_t history_offset = 0; // oldest entry, the next to be overwritten
+  int32_t history_count = 0; // entries filled so far
+  // over the history, in ms
+  float mean = 0.0f;
+  float jitter = 0.0f; // standard deviation of the frame time
+  float frame_to_frame = 0.0f; // mean change between consecutive frames
+  float max = 0.0f;
+};
+
+const char* pacing_mode_name(pacing_mode_e mode);
+
+// needs the gl context to be current, the swap interval is per context
+frame_pacer_t create_frame_pacer(
+  pacing_mode_e mode, int32_t history_size = 240);
+void set_frame_pacing_mode(frame_pacer_t& frame_pacer, pacing_mode_e mode);
+
+// call at the start of every frame, returns the time since the previous call
+// in seconds (0 the first time)
+float begin_frame_pacer_frame(frame_pacer_t& frame_pacer);
+
+// call right before swapping, waits out the rest of the frame when limited
+void wait_frame_pacer(frame_pacer_t& frame_pacer);
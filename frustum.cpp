@@ -0,0 +1,54 @@
+#include "frustum.hpp"
+
+#include <cmath>
+
+frustum_planes_t frustum_planes_from_view_projection(
+  const as::mat4& view_projection)
+{
+  // as stores matrices so clip[j] = dot(position, column j of the raw data),
+  // this is true for both row and column major builds (it's also what lets
+  // the data go straight to glUniformMatrix4fv without transposing)
+  const float* data = as::mat_const_data(view_projection);
+  const auto clip = [data](const int j, const int i) {
+    return data[i * 4 + j];
+  };
+
+  frustum_planes_t frustum;
+  for (int i = 0; i < 4; ++i) {
+    const float x = clip(0, i);
+    const float y = clip(1, i);
+    const float z = clip(2, i);
+    const float w = clip(3, i);
+    frustum.planes[0][i] = w + x; // left
+    frustum.planes[1][i] = w - x; // right
+    frustum.planes[2][i] = w + y; // bottom
+    frustum.planes[3][i] = w - y; // top
+    frustum.planes[4][i] = z; // 0 <= z (near, or far when reversed)
+    frustum.planes[5][i] = w - z; // z <= w (far, or near when reversed)
+  }
+
+  // normalize so plane distances are in world units (for sphere tests)
+  for (auto& plane : frustum.planes) {
+    const float length = std::sqrt(
+      plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+    for (float& component : plane) {
+      component /= length;
+    }
+  }
+
+  return frustum;
+}
+
+bounding_sphere_t quad_bounding_sphere(const as::mat4& model)
+{
+  // the translation and the first two basis vectors are at the same offsets
+  // for row and column major builds
+  const float* data = as::mat_const_data(model);
+  const auto length = [](const float* v) {
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  };
+  // corners are at +/-0.5 along each basis vector
+  return bounding_sphere_t{
+    data[12], data[13], data[14],
+    0.5f * (length(&data[0]) + length(&data[4]))};
+}
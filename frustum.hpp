@@ -0,0 +1,27 @@
+#pragma once
+
+#include <as/as-math-ops.hpp>
+
+// planes are stored as (a, b, c, d) with the normal pointing inwards, a point
+// p is inside a plane when dot(abc, p) + d >= 0
+// order: left, right, bottom, top, near, far (near/far swap for reverse z)
+struct frustum_planes_t
+{
+  float planes[6][4];
+};
+
+struct bounding_sphere_t
+{
+  float x;
+  float y;
+  float z;
+  float radius;
+};
+
+// expects clip space depth in [0, w] (glClipControl with GL_ZERO_TO_ONE), this
+// holds for both normal and reverse z projections
+frustum_planes_t frustum_planes_from_view_projection(
+  const as::mat4& view_projection);
+
+// bounds of the unit quad in the xy plane (see vertices in main.cpp)
+bounding_sphere_t quad_bounding_sphere(const as::mat4& model);
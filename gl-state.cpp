@@ -0,0 +1,381 @@
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <iterator>
+
+constexpr int g_shadowed_texture_units = 16;
+constexpr GLenum g_shadowed_caps[] = {
+  GL_BLEND,        GL_CULL_FACE,    GL_DEPTH_TEST,
+  GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_PRIMITIVE_RESTART};
+
+struct gl_state_shadow_t
+{
+  uint32_t program = 0;
+  uint32_t vertex_array = 0;
+  uint32_t array_buffer = 0;
+  uint32_t active_texture = GL_TEXTURE0;
+  uint32_t textures[g_shadowed_texture_units] = {};
+  uint32_t samplers[g_shadowed_texture_units] = {};
+  bool enabled[std::size(g_shadowed_caps)] = {};
+  uint32_t blend_equation_rgb = GL_FUNC_ADD;
+  uint32_t blend_equation_alpha = GL_FUNC_ADD;
+  uint32_t blend_src_rgb = GL_ONE;
+  uint32_t blend_dst_rgb = GL_ZERO;
+  uint32_t blend_src_alpha = GL_ONE;
+  uint32_t blend_dst_alpha = GL_ZERO;
+  uint32_t depth_func = GL_LESS;
+  int32_t viewport[4] = {};
+  int32_t scissor[4] = {};
+  uint32_t polygon_mode = GL_FILL;
+};
+
+static gl_state_shadow_t g_shadow;
+static gl_state_stats_t g_stats;
+
+// counts the change, returns true if it has to reach the driver
+static bool record_change(const bool changed)
+{
+  if (changed) {
+    g_stats.issued++;
+  } else {
+    g_stats.elided++;
+  }
+  return changed;
+}
+
+// index into g_shadowed_caps, -1 if the capability isn't shadowed
+static int cap_index(const uint32_t cap)
+{
+  const auto it =
+    std::find(std::begin(g_shadowed_caps), std::end(g_shadowed_caps), cap);
+  return it != std::end(g_shadowed_caps)
+         ? static_cast<int>(it - std::begin(g_shadowed_caps))
+         : -1;
+}
+
+// index of the active texture unit, -1 if beyond the shadowed units
+static int active_unit()
+{
+  const int unit = static_cast<int>(g_shadow.active_texture - GL_TEXTURE0);
+  return unit < g_shadowed_texture_units ? unit : -1;
+}
+
+static uint32_t get_unsigned(const GLenum pname)
+{
+  int32_t value = 0;
+  glGetIntegerv(pname, &value);
+  return static_cast<uint32_t>(value);
+}
+
+void sync_gl_state()
+{
+  g_shadow.program = get_unsigned(GL_CURRENT_PROGRAM);
+  g_shadow.vertex_array = get_unsigned(GL_VERTEX_ARRAY_BINDING);
+  g_shadow.array_buffer = get_unsigned(GL_ARRAY_BUFFER_BINDING);
+  g_shadow.active_texture = get_unsigned(GL_ACTIVE_TEXTURE);
+  for (int unit = 0; unit < g_shadowed_texture_units; ++unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    g_shadow.textures[unit] = get_unsigned(GL_TEXTURE_BINDING_2D);
+    g_shadow.samplers[unit] = get_unsigned(GL_SAMPLER_BINDING);
+  }
+  glActiveTexture(g_shadow.active_texture);
+  for (size_t i = 0; i < std::size(g_shadowed_caps); ++i) {
+    g_shadow.enabled[i] = glIsEnabled(g_shadowed_caps[i]) == GL_TRUE;
+  }
+  g_shadow.blend_equation_rgb = get_unsigned(GL_BLEND_EQUATION_RGB);
+  g_shadow.blend_equation_alpha = get_unsigned(GL_BLEND_EQUATION_ALPHA);
+  g_shadow.blend_src_rgb = get_unsigned(GL_BLEND_SRC_RGB);
+  g_shadow.blend_dst_rgb = get_unsigned(GL_BLEND_DST_RGB);
+  g_shadow.blend_src_alpha = get_unsigned(GL_BLEND_SRC_ALPHA);
+  g_shadow.blend_dst_alpha = get_unsigned(GL_BLEND_DST_ALPHA);
+  g_shadow.depth_func = get_unsigned(GL_DEPTH_FUNC);
+  glGetIntegerv(GL_VIEWPORT, g_shadow.viewport);
+  glGetIntegerv(GL_SCISSOR_BOX, g_shadow.scissor);
+  int32_t polygon_mode[2] = {GL_FILL, GL_FILL};
+  glGetIntegerv(GL_POLYGON_MODE, polygon_mode);
+  g_shadow.polygon_mode = static_cast<uint32_t>(polygon_mode[0]);
+}
+
+void gl_state_use_program(const uint32_t program)
+{
+  if (record_change(g_shadow.program != program)) {
+    g_shadow.program = program;
+    glUseProgram(program);
+  }
+}
+
+void gl_state_bind_vertex_array(const uint32_t vertex_array)
+{
+  if (record_change(g_shadow.vertex_array != vertex_array)) {
+    g_shadow.vertex_array = vertex_array;
+    glBindVertexArray(vertex_array);
+  }
+}
+
+void gl_state_bind_buffer(const uint32_t target, const uint32_t buffer)
+{
+  if (target != GL_ARRAY_BUFFER) {
+    record_change(true);
+    glBindBuffer(target, buffer);
+    return;
+  }
+  if (record_change(g_shadow.array_buffer != buffer)) {
+    g_shadow.array_buffer = buffer;
+    glBindBuffer(target, buffer);
+  }
+}
+
+void gl_state_active_texture(const uint32_t texture_unit)
+{
+  if (record_change(g_shadow.active_texture != texture_unit)) {
+    g_shadow.active_texture = texture_unit;
+    glActiveTexture(texture_unit);
+  }
+}
+
+void gl_state_bind_texture(const uint32_t target, const uint32_t texture)
+{
+  const int unit = active_unit();
+  if (target != GL_TEXTURE_2D || unit == -1) {
+    record_change(true);
+    glBindTexture(target, texture);
+    return;
+  }
+  if (record_change(g_shadow.textures[unit] != texture)) {
+    g_shadow.textures[unit] = texture;
+    glBindTexture(target, texture);
+  }
+}
+
+void gl_state_bind_sampler(const uint32_t unit, const uint32_t sampler)
+{
+  if (unit >= uint32_t(g_shadowed_texture_units)) {
+    record_change(true);
+    glBindSampler(unit, sampler);
+    return;
+  }
+  if (record_change(g_shadow.samplers[unit] != sampler)) {
+    g_shadow.samplers[unit] = sampler;
+    glBindSampler(unit, sampler);
+  }
+}
+
+static void set_cap(const uint32_t cap, const bool enabled)
+{
+  if (const int index = cap_index(cap); index != -1) {
+    if (!record_change(g_shadow.enabled[index] != enabled)) {
+      return;
+    }
+    g_shadow.enabled[index] = enabled;
+  } else {
+    record_change(true);
+  }
+  if (enabled) {
+    glEnable(cap);
+  } else {
+    glDisable(cap);
+  }
+}
+
+void gl_state_enable(const uint32_t cap)
+{
+  set_cap(cap, true);
+}
+
+void gl_state_disable(const uint32_t cap)
+{
+  set_cap(cap, false);
+}
+
+void gl_state_blend_equation(const uint32_t mode)
+{
+  gl_state_blend_equation_separate(mode, mode);
+}
+
+void gl_state_blend_equation_separate(
+  const uint32_t mode_rgb, const uint32_t mode_alpha)
+{
+  if (record_change(
+        g_shadow.blend_equation_rgb != mode_rgb
+        || g_shadow.blend_equation_alpha != mode_alpha)) {
+    g_shadow.blend_equation_rgb = mode_rgb;
+    g_shadow.blend_equation_alpha = mode_alpha;
+    glBlendEquationSeparate(mode_rgb, mode_alpha);
+  }
+}
+
+void gl_state_blend_func_separate(
+  const uint32_t src_rgb, const uint32_t dst_rgb, const uint32_t src_alpha,
+  const uint32_t dst_alpha)
+{
+  if (record_change(
+        g_shadow.blend_src_rgb != src_rgb || g_shadow.blend_dst_rgb != dst_rgb
+        || g_shadow.blend_src_alpha != src_alpha
+        || g_shadow.blend_dst_alpha != dst_alpha)) {
+    g_shadow.blend_src_rgb = src_rgb;
+    g_shadow.blend_dst_rgb = dst_rgb;
+    g_shadow.blend_src_alpha = src_alpha;
+    g_shadow.blend_dst_alpha = dst_alpha;
+    glBlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+  }
+}
+
+void gl_state_depth_func(const uint32_t func)
+{
+  if (record_change(g_shadow.depth_func != func)) {
+    g_shadow.depth_func = func;
+    glDepthFunc(func);
+  }
+}
+
+static bool set_rect(
+  int32_t (&rect)[4], const int32_t x, const int32_t y, const int32_t width,
+  const int32_t height)
+{
+  const int32_t next[4] = {x, y, width, height};
+  if (!record_change(!std::equal(std::begin(rect), std::end(rect), next))) {
+    return false;
+  }
+  std::copy(std::begin(next), std::end(next), rect);
+  return true;
+}
+
+void gl_state_viewport(
+  const int32_t x, const int32_t y, const int32_t width, const int32_t height)
+{
+  if (set_rect(g_shadow.viewport, x, y, width, height)) {
+    glViewport(x, y, width, height);
+  }
+}
+
+void gl_state_scissor(
+  const int32_t x, const int32_t y, const int32_t width, const int32_t height)
+{
+  if (set_rect(g_shadow.scissor, x, y, width, height)) {
+    glScissor(x, y, width, height);
+  }
+}
+
+void gl_state_polygon_mode(const uint32_t face, const uint32_t mode)
+{
+  // core profile only accepts GL_FRONT_AND_BACK
+  if (face != GL_FRONT_AND_BACK) {
+    record_change(true);
+    glPolygonMode(face, mode);
+    return;
+  }
+  if (record_change(g_shadow.polygon_mode != mode)) {
+    g_shadow.polygon_mode = mode;
+    glPolygonMode(face, mode);
+  }
+}
+
+void gl_state_delete_textures(const int32_t count, const uint32_t* textures)
+{
+  for (int32_t i = 0; i < count; ++i) {
+    std::replace(
+      std::begin(g_shadow.textures), std::end(g_shadow.textures), textures[i],
+      0u);
+  }
+  glDeleteTextures(count, textures);
+}
+
+void gl_state_delete_buffers(const int32_t count, const uint32_t* buffers)
+{
+  for (int32_t i = 0; i < count; ++i) {
+    if (g_shadow.array_buffer == buffers[i]) {
+      g_shadow.array_buffer = 0;
+    }
+  }
+  glDeleteBuffers(count, buffers);
+}
+
+void gl_state_delete_vertex_arrays(
+  const int32_t count, const uint32_t* vertex_arrays)
+{
+  for (int32_t i = 0; i < count; ++i) {
+    if (g_shadow.vertex_array == vertex_arrays[i]) {
+      g_shadow.vertex_array = 0;
+    }
+  }
+  glDeleteVertexArrays(count, vertex_arrays);
+}
+
+void gl_state_delete_program(const uint32_t program)
+{
+  // a current program would only be flagged for deletion, unbinding it
+  // first frees it now and keeps the shadow matching
+  if (g_shadow.program == program) {
+    gl_state_use_program(0);
+  }
+  glDeleteProgram(program);
+}
+
+// returns false if pname isn't shadowed (data is left untouched)
+static bool shadowed_integerv(const uint32_t pname, int32_t* data)
+{
+  const auto set = [data](const uint32_t value) {
+    data[0] = static_cast<int32_t>(value);
+    return true;
+  };
+  const int unit = active_unit();
+  switch (pname) {
+    // clang-format off
+    case GL_CURRENT_PROGRAM: return set(g_shadow.program);
+    case GL_VERTEX_ARRAY_BINDING: return set(g_shadow.vertex_array);
+    case GL_ARRAY_BUFFER_BINDING: return set(g_shadow.array_buffer);
+    case GL_ACTIVE_TEXTURE: return set(g_shadow.active_texture);
+    case GL_BLEND_EQUATION_RGB: return set(g_shadow.blend_equation_rgb);
+    case GL_BLEND_EQUATION_ALPHA: return set(g_shadow.blend_equation_alpha);
+    case GL_BLEND_SRC_RGB: return set(g_shadow.blend_src_rgb);
+    case GL_BLEND_DST_RGB: return set(g_shadow.blend_dst_rgb);
+    case GL_BLEND_SRC_ALPHA: return set(g_shadow.blend_src_alpha);
+    case GL_BLEND_DST_ALPHA: return set(g_shadow.blend_dst_alpha);
+    case GL_DEPTH_FUNC: return set(g_shadow.depth_func);
+    // clang-format on
+    case GL_TEXTURE_BINDING_2D:
+      return unit != -1 && set(g_shadow.textures[unit]);
+    case GL_SAMPLER_BINDING:
+      return unit != -1 && set(g_shadow.samplers[unit]);
+    case GL_VIEWPORT:
+      std::copy(
+        std::begin(g_shadow.viewport), std::end(g_shadow.viewport), data);
+      return true;
+    case GL_SCISSOR_BOX:
+      std::copy(
+        std::begin(g_shadow.scissor), std::end(g_shadow.scissor), data);
+      return true;
+    case GL_POLYGON_MODE:
+      data[0] = data[1] = static_cast<int32_t>(g_shadow.polygon_mode);
+      return true;
+    default:
+      return false;
+  }
+}
+
+void gl_state_get_integerv(const uint32_t pname, int32_t* data)
+{
+  if (shadowed_integerv(pname, data)) {
+    g_stats.queries_shadowed++;
+    return;
+  }
+  g_stats.queries_forwarded++;
+  glGetIntegerv(pname, data);
+}
+
+bool gl_state_is_enabled(const uint32_t cap)
+{
+  if (const int index = cap_index(cap); index != -1) {
+    g_stats.queries_shadowed++;
+    return g_shadow.enabled[index];
+  }
+  g_stats.queries_forwarded++;
+  return glIsEnabled(cap) == GL_TRUE;
+}
+
+gl_state_stats_t gl_state_stats()
+{
+  return g_stats;
+}
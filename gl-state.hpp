@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+// a cpu side shadow of the gl state changed every frame by the renderer and
+// the imgui backend, changes that match the shadow are not sent to the
+// driver and queries for shadowed state are answered without a round trip
+// state changed directly with gl (not through these functions) leaves the
+// shadow stale, call sync_gl_state afterwards
+//
+// shadowed: current program, vertex array, array buffer, active texture,
+// 2d texture and sampler bindings (first 16 units), blend, cull face, depth
+// test, stencil test, scissor test and primitive restart capabilities, blend
+// equation/function, depth function, viewport, scissor box and polygon mode
+// anything else is forwarded as is
+
+struct gl_state_stats_t
+{
+  uint64_t issued = 0; // changes sent to the driver
+  uint64_t elided = 0; // redundant changes skipped
+  uint64_t queries_shadowed = 0; // queries answered from the shadow
+  uint64_t queries_forwarded = 0; // queries for state that isn't shadowed
+};
+
+// reads every shadowed value back from the driver, call once the context is
+// current and whenever the shadow may have gone stale
+void sync_gl_state();
+
+void gl_state_use_program(uint32_t program);
+void gl_state_bind_vertex_array(uint32_t vertex_array);
+void gl_state_bind_buffer(uint32_t target, uint32_t buffer);
+void gl_state_active_texture(uint32_t texture_unit); // GL_TEXTURE0 + i
+void gl_state_bind_texture(uint32_t target, uint32_t texture);
+void gl_state_bind_sampler(uint32_t unit, uint32_t sampler);
+void gl_state_enable(uint32_t cap);
+void gl_state_disable(uint32_t cap);
+void gl_state_blend_equation(uint32_t mode);
+void gl_state_blend_equation_separate(uint32_t mode_rgb, uint32_t mode_alpha);
+void gl_state_blend_func_separate(
+  uint32_t src_rgb, uint32_t dst_rgb, uint32_t src_alpha, uint32_t dst_alpha);
+void gl_state_depth_func(uint32_t func);
+void gl_state_viewport(int32_t x, int32_t y, int32_t width, int32_t height);
+void gl_state_scissor(int32_t x, int32_t y, int32_t width, int32_t height);
+void gl_state_polygon_mode(uint32_t face, uint32_t mode);
+
+// delete through these so the shadow forgets the names, gl unbinds a deleted
+// object and may hand its name out again, a stale shadow entry would then
+// elide the first bind of the new object
+void gl_state_delete_textures(int32_t count, const uint32_t* textures);
+void gl_state_delete_buffers(int32_t count, const uint32_t* buffers);
+void gl_state_delete_vertex_arrays(
+  int32_t count, const uint32_t* vertex_arrays);
+void gl_state_delete_program(uint32_t program);
+
+// same contract as glGetIntegerv/glIsEnabled
+void gl_state_get_integerv(uint32_t pname, int32_t* data);
+bool gl_state_is_enabled(uint32_t cap);
+
+// running totals since startup, sample them each frame for per-frame counts
+gl_state_stats_t gl_state_stats();
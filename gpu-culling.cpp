@@ -0,0 +1,296 @@
+#include "gpu-culling.hpp"
+
+#include "draw-commands.hpp"
+#include "frustum.hpp"
+#include "gl-state.hpp"
+#include "hiz.hpp"
+#include "instanced-quads.hpp"
+#include "shader.hpp"
+
+#include <glad/gl.h>
+
+#include <cstddef>
+#include <iterator>
+
+const char* const g_cull_compute_shader_source =
+  R"(#version 460 core
+layout (local_size_x = 64) in;
+struct draw_command_t
+{
+  uint count;
+  uint instance_count;
+  uint first_index;
+  int base_vertex;
+  uint base_instance;
+};
+layout (std430, binding = 1) readonly buffer bounds
+{
+  vec4 spheres[];
+};
+layout (std430, binding = 2) writeonly buffer visible
+{
+  uint visible_instances[];
+};
+layout (std430, binding = 3) buffer command
+{
+  draw_command_t draw_command;
+};
+uniform vec4 frustum_planes[6];
+uniform uint instance_count;
+uniform bool occlusion_culling;
+uniform mat4 hiz_view_projection;
+uniform bool hiz_reverse_z;
+uniform int hiz_mip_count;
+uniform ivec2 hiz_size; // area of level 0 in use, the rest is stale
+uniform sampler2D hiz;
+// tests the sphere against the previous frame's depth pyramid, anything not
+// fully on screen last frame is treated as visible
+bool occluded(const vec4 sphere)
+{
+  vec3 ndc_min = vec3(1.0e30);
+  vec3 ndc_max = vec3(-1.0e30);
+  for (int i = 0; i < 8; ++i) {
+    const vec3 corner = vec3(
+      (i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0,
+      (i & 4) != 0 ? 1.0 : -1.0);
+    const vec4 clip =
+      hiz_view_projection * vec4(sphere.xyz + corner * sphere.w, 1.0);
+    if (clip.w <= 0.0) {
+      return false;
+    }
+    const vec3 ndc = clip.xyz / clip.w;
+    ndc_min = min(ndc_min, ndc);
+    ndc_max = max(ndc_max, ndc);
+  }
+  if (any(lessThan(ndc_min.xy, vec2(-1.0)))
+      || any(greaterThan(ndc_max.xy, vec2(1.0)))) {
+    return false;
+  }
+  // pick the level where the bounds cover at most 2x2 texels
+  const ivec2 texel_min = clamp(
+    ivec2((ndc_min.xy * 0.5 + 0.5) * vec2(hiz_size)), ivec2(0), hiz_size - 1);
+  const ivec2 texel_max = clamp(
+    ivec2((ndc_max.xy * 0.5 + 0.5) * vec2(hiz_size)), ivec2(0), hiz_size - 1);
+  const ivec2 extent = texel_max - texel_min;
+  const int level =
+    min(findMSB(max(extent.x, extent.y)) + 1, hiz_mip_count - 1);
+  const ivec2 level_max = max(hiz_size >> level, ivec2(1)) - 1;
+  const ivec2 lo = min(texel_min >> level, level_max);
+  const ivec2 hi = min(texel_max >> level, level_max);
+  const vec4 depths = vec4(
+    texelFetch(hiz, lo, level).r, texelFetch(hiz, ivec2(hi.x, lo.y), level).r,
+    texelFetch(hiz, ivec2(lo.x, hi.y), level).r, texelFetch(hiz, hi, level).r);
+  // occluded when the nearest point of the bounds is behind the farthest
+  // depth already drawn in that area
+  if (hiz_reverse_z) {
+    return ndc_max.z < min(min(depths.x, depths.y), min(depths.z, depths.w));
+  }
+  return ndc_min.z > max(max(depths.x, depths.y), max(depths.z, depths.w));
+}
+void main()
+{
+  const uint index = gl_GlobalInvocationID.x;
+  if (index >= instance_count) {
+    return;
+  }
+  const vec4 sphere = spheres[index];
+  for (int i = 0; i < 6; ++i) {
+    if (dot(frustum_planes[i].xyz, sphere.xyz) + frustum_planes[i].w
+        < -sphere.w) {
+      return;
+    }
+  }
+  if (occlusion_culling && occluded(sphere)) {
+    return;
+  }
+  const uint slot = atomicAdd(draw_command.instance_count, 1u);
+  visible_instances[slot] = index;
+})";
+
+const char* const g_culled_vertex_shader_source =
+  R"(#version 460 core
+layout (location = 0) in vec3 aPos;
+struct instance_t
+{
+  mat4 model;
+  vec4 color;
+};
+layout (std430, binding = 0) readonly buffer instances
+{
+  instance_t instance_data[];
+};
+layout (std430, binding = 2) readonly buffer visible
+{
+  uint visible_instances[];
+};
+layout (std140, binding = 2) uniform camera
+{
+  mat4 view_projection;
+};
+out vec4 Color;
+void main()
+{
+  const instance_t instance = instance_data[visible_instances[gl_InstanceID]];
+  gl_Position = view_projection * instance.model * vec4(aPos, 1.0);
+  Color = instance.color;
+})";
+
+const char* const g_culled_fragment_shader_source =
+  R"(#version 460 core
+out vec4 FragColor;
+in vec4 Color;
+void main()
+{
+  FragColor = Color;
+})";
+
+gpu_culling_t create_gpu_culling()
+{
+  gpu_culling_t gpu_culling;
+  gpu_culling.cull_program =
+    create_compute_shader(g_cull_compute_shader_source);
+  gpu_culling.frustum_planes_loc =
+    shader_uniform_location(gpu_culling.cull_program, "frustum_planes");
+  gpu_culling.instance_count_loc =
+    shader_uniform_location(gpu_culling.cull_program, "instance_count");
+  gpu_culling.occlusion_culling_loc =
+    shader_uniform_location(gpu_culling.cull_program, "occlusion_culling");
+  gpu_culling.hiz_view_projection_loc =
+    shader_uniform_location(gpu_culling.cull_program, "hiz_view_projection");
+  gpu_culling.hiz_reverse_z_loc =
+    shader_uniform_location(gpu_culling.cull_program, "hiz_reverse_z");
+  gpu_culling.hiz_mip_count_loc =
+    shader_uniform_location(gpu_culling.cull_program, "hiz_mip_count");
+  gpu_culling.hiz_size_loc =
+    shader_uniform_location(gpu_culling.cull_program, "hiz_size");
+
+  gpu_culling.draw_program = create_shader(
+    g_culled_vertex_shader_source, g_culled_fragment_shader_source);
+
+  glGenBuffers(1, &gpu_culling.bounds_buffer);
+  glGenBuffers(1, &gpu_culling.visible_buffer);
+
+  glGenBuffers(1, &gpu_culling.command_buffer);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpu_culling.command_buffer);
+  glBufferData(
+    GL_DRAW_INDIRECT_BUFFER, sizeof(draw_elements_indirect_command_t), nullptr,
+    GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+  glGenBuffers(
+    std::size(gpu_culling.readback_buffers), gpu_culling.readback_buffers);
+  for (const uint32_t readback_buffer : gpu_culling.readback_buffers) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, readback_buffer);
+    glBufferData(
+      GL_COPY_WRITE_BUFFER, sizeof(uint32_t), nullptr, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  return gpu_culling;
+}
+
+void destroy_gpu_culling(gpu_culling_t& gpu_culling)
+{
+  gl_state_delete_buffers(
+    static_cast<int32_t>(std::size(gpu_culling.readback_buffers)),
+    gpu_culling.readback_buffers);
+  gl_state_delete_buffers(1, &gpu_culling.command_buffer);
+  gl_state_delete_buffers(1, &gpu_culling.visible_buffer);
+  gl_state_delete_buffers(1, &gpu_culling.bounds_buffer);
+  destroy_shader(gpu_culling.draw_program);
+  destroy_shader(gpu_culling.cull_program);
+  gpu_culling = gpu_culling_t{};
+}
+
+void upload_gpu_culling_bounds(
+  gpu_culling_t& gpu_culling, const std::vector<quad_instance_t>& quads)
+{
+  std::vector<bounding_sphere_t> spheres;
+  spheres.reserve(quads.size());
+  for (const quad_instance_t& quad : quads) {
+    spheres.push_back(quad_bounding_sphere(quad.model));
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu_culling.bounds_buffer);
+  glBufferData(
+    GL_SHADER_STORAGE_BUFFER, spheres.size() * sizeof(bounding_sphere_t),
+    spheres.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu_culling.visible_buffer);
+  glBufferData(
+    GL_SHADER_STORAGE_BUFFER, quads.size() * sizeof(uint32_t), nullptr,
+    GL_DYNAMIC_COPY);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  gpu_culling.instance_count = static_cast<int32_t>(quads.size());
+}
+
+void cull_and_draw_quads(
+  gpu_culling_t& gpu_culling, const as::mat4& view_projection,
+  const uint32_t vao, const uint32_t instance_buffer, const hiz_t* hiz)
+{
+  // reset the instance count, the compute pass accumulates into it
+  const draw_elements_indirect_command_t command{6, 0, 0, 0, 0};
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpu_culling.command_buffer);
+  glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(command), &command);
+
+  const frustum_planes_t frustum =
+    frustum_planes_from_view_projection(view_projection);
+
+  gl_state_use_program(gpu_culling.cull_program.id);
+  glUniform4fv(gpu_culling.frustum_planes_loc, 6, &frustum.planes[0][0]);
+  glUniform1ui(gpu_culling.instance_count_loc, gpu_culling.instance_count);
+  const bool occlusion_culling = hiz != nullptr && hiz->valid;
+  glUniform1i(gpu_culling.occlusion_culling_loc, occlusion_culling);
+  if (occlusion_culling) {
+    glUniformMatrix4fv(
+      gpu_culling.hiz_view_projection_loc, 1, GL_FALSE,
+      as::mat_const_data(hiz->view_projection));
+    glUniform1i(gpu_culling.hiz_reverse_z_loc, hiz->reverse_z);
+    glUniform1i(gpu_culling.hiz_mip_count_loc, hiz->render_mip_count);
+    glUniform2i(
+      gpu_culling.hiz_size_loc, hiz->render_width, hiz->render_height);
+    gl_state_active_texture(GL_TEXTURE0);
+    gl_state_bind_texture(GL_TEXTURE_2D, hiz->texture);
+  }
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_culling.bounds_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpu_culling.visible_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpu_culling.command_buffer);
+  glDispatchCompute((gpu_culling.instance_count + 63) / 64, 1, 1);
+
+  // the count written with atomics is read by the indirect draw, copied to
+  // the readback ring and reset by next frame's glBufferSubData, copies and
+  // updates are only ordered after shader writes by the buffer update bit
+  glMemoryBarrier(
+    GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT
+    | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+  gl_state_use_program(gpu_culling.draw_program.id);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instance_buffer);
+  gl_state_bind_vertex_array(vao);
+  glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr);
+
+  // copy this frame's count and read the oldest one back (the gpu will have
+  // finished with it by now so this should not stall)
+  const uint32_t readback_count = std::size(gpu_culling.readback_buffers);
+  glBindBuffer(GL_COPY_READ_BUFFER, gpu_culling.command_buffer);
+  glBindBuffer(
+    GL_COPY_WRITE_BUFFER,
+    gpu_culling.readback_buffers[gpu_culling.frame % readback_count]);
+  glCopyBufferSubData(
+    GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+    offsetof(draw_elements_indirect_command_t, instance_count), 0,
+    sizeof(uint32_t));
+  gpu_culling.frame++;
+  if (gpu_culling.frame >= readback_count) {
+    glBindBuffer(
+      GL_COPY_WRITE_BUFFER,
+      gpu_culling.readback_buffers[gpu_culling.frame % readback_count]);
+    glGetBufferSubData(
+      GL_COPY_WRITE_BUFFER, 0, sizeof(uint32_t), &gpu_culling.visible_count);
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+}
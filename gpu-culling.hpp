@@ -0,0 +1,52 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <as/as-math-ops.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct hiz_t;
+struct quad_instance_t;
+
+// a compute pass tests every instance bounding sphere against the view
+// frustum and appends the visible ones to a list, the count of which is
+// written (with an atomic) straight into the instance count of an indirect
+// draw command so culled quads never reach the rasterizer
+struct gpu_culling_t
+{
+  shader_program_t cull_program;
+  shader_program_t draw_program;
+  uint32_t bounds_buffer = 0;
+  uint32_t visible_buffer = 0;
+  uint32_t command_buffer = 0;
+  uint32_t readback_buffers[3] = {};
+  int32_t frustum_planes_loc = -1;
+  int32_t instance_count_loc = -1;
+  int32_t occlusion_culling_loc = -1;
+  int32_t hiz_view_projection_loc = -1;
+  int32_t hiz_reverse_z_loc = -1;
+  int32_t hiz_mip_count_loc = -1;
+  int32_t hiz_size_loc = -1;
+  int32_t instance_count = 0;
+  // visible count from a previous frame (read back without stalling)
+  int32_t visible_count = 0;
+  uint32_t frame = 0;
+};
+
+gpu_culling_t create_gpu_culling();
+void destroy_gpu_culling(gpu_culling_t& gpu_culling);
+
+// only required when the quads change, not every frame
+void upload_gpu_culling_bounds(
+  gpu_culling_t& gpu_culling, const std::vector<quad_instance_t>& quads);
+
+// instance_buffer holds an array of quad_instance_t (see instanced-quads.hpp)
+// view_projection is only used to cull, the draw reads the camera uniform
+// block (binding 2) so it can be updated after culling
+// when hiz is provided (and valid) instances hidden behind what was drawn the
+// previous frame are also culled
+void cull_and_draw_quads(
+  gpu_culling_t& gpu_culling, const as::mat4& view_projection, uint32_t vao,
+  uint32_t instance_buffer, const hiz_t* hiz = nullptr);
@@ -0,0 +1,86 @@
+#include "gpu-profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+gpu_profiler_t create_gpu_profiler(const int32_t history_size)
+{
+  gpu_profiler_t gpu_profiler;
+  gpu_profiler.history_size = history_size;
+  return gpu_profiler;
+}
+
+void destroy_gpu_profiler(gpu_profiler_t& gpu_profiler)
+{
+  for (gpu_profiler_pass_t& pass : gpu_profiler.passes) {
+    destroy_gpu_timer(pass.timer);
+  }
+  gpu_profiler = gpu_profiler_t{};
+}
+
+int32_t add_gpu_profiler_pass(
+  gpu_profiler_t& gpu_profiler, const char* name)
+{
+  gpu_profiler_pass_t pass;
+  pass.name = name;
+  pass.timer = create_gpu_timer();
+  pass.history.resize(gpu_profiler.history_size, 0.0f);
+  gpu_profiler.passes.push_back(std::move(pass));
+  return static_cast<int32_t>(gpu_profiler.passes.size() - 1);
+}
+
+void begin_gpu_profiler_pass(gpu_profiler_t& gpu_profiler, const int32_t pass)
+{
+  begin_gpu_timer(gpu_profiler.passes[pass].timer);
+}
+
+void end_gpu_profiler_pass(gpu_profiler_t& gpu_profiler, const int32_t pass)
+{
+  end_gpu_timer(gpu_profiler.passes[pass].timer);
+  gpu_profiler.passes[pass].active = true;
+}
+
+void end_gpu_profiler_frame(gpu_profiler_t& gpu_profiler)
+{
+  for (gpu_profiler_pass_t& pass : gpu_profiler.passes) {
+    pass.history[gpu_profiler.history_offset] =
+      pass.active ? pass.timer.time * 1000.0f : 0.0f;
+    pass.active = false;
+  }
+  gpu_profiler.history_offset =
+    (gpu_profiler.history_offset + 1) % gpu_profiler.history_size;
+  gpu_profiler.frame_count++;
+}
+
+bool write_gpu_profiler_csv(
+  const gpu_profiler_t& gpu_profiler, const char* path)
+{
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::fprintf(file, "frame");
+  for (const gpu_profiler_pass_t& pass : gpu_profiler.passes) {
+    std::fprintf(file, ",%s_ms", pass.name);
+  }
+  std::fprintf(file, "\n");
+
+  // only what's been recorded when the history hasn't filled up yet
+  const auto row_count = static_cast<int32_t>(std::min(
+    gpu_profiler.frame_count, int64_t(gpu_profiler.history_size)));
+  const int64_t first_frame = gpu_profiler.frame_count - row_count;
+  for (int32_t row = 0; row < row_count; ++row) {
+    const int32_t index =
+      (gpu_profiler.history_offset + gpu_profiler.history_size - row_count
+       + row)
+      % gpu_profiler.history_size;
+    std::fprintf(file, "%lld", static_cast<long long>(first_frame + row));
+    for (const gpu_profiler_pass_t& pass : gpu_profiler.passes) {
+      std::fprintf(file, ",%.4f", pass.history[index]);
+    }
+    std::fprintf(file, "\n");
+  }
+
+  return std::fclose(file) == 0;
+}
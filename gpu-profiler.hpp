@@ -0,0 +1,41 @@
+#pragma once
+
+#include "gpu-timer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// named gpu passes timed with a gpu_timer_t each (so results come back a few
+// frames late without stalling), every frame the latest time of each pass is
+// appended to a rolling history for graphing and writing out as csv
+struct gpu_profiler_pass_t
+{
+  const char* name = nullptr; // must outlive the profiler
+  gpu_timer_t timer;
+  std::vector<float> history; // ms per frame, 0 when the pass didn't run
+  bool active = false; // ran this frame
+};
+
+struct gpu_profiler_t
+{
+  std::vector<gpu_profiler_pass_t> passes;
+  int32_t history_size = 0;
+  int32_t history_offset = 0; // oldest entry, the next to be overwritten
+  int64_t frame_count = 0; // frames recorded so far
+};
+
+gpu_profiler_t create_gpu_profiler(int32_t history_size = 240);
+void destroy_gpu_profiler(gpu_profiler_t& gpu_profiler);
+
+// returns the index passed to begin/end
+int32_t add_gpu_profiler_pass(gpu_profiler_t& gpu_profiler, const char* name);
+
+void begin_gpu_profiler_pass(gpu_profiler_t& gpu_profiler, int32_t pass);
+void end_gpu_profiler_pass(gpu_profiler_t& gpu_profiler, int32_t pass);
+
+// records this frame's time for every pass, call once all passes have ended
+void end_gpu_profiler_frame(gpu_profiler_t& gpu_profiler);
+
+// history oldest first, a row per frame and a column per pass
+bool write_gpu_profiler_csv(
+  const gpu_profiler_t& gpu_profiler, const char* path);
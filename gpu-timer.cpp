@@ -0,0 +1,84 @@
+#include "gpu-timer.hpp"
+
+#include <glad/gl.h>
+
+gpu_timer_t create_gpu_timer(const int32_t latency)
+{
+  gpu_timer_t gpu_timer;
+  gpu_timer.queries.resize(latency * 2);
+  glGenQueries(latency * 2, gpu_timer.queries.data());
+  return gpu_timer;
+}
+
+void destroy_gpu_timer(gpu_timer_t& gpu_timer)
+{
+  glDeleteQueries(
+    static_cast<int32_t>(gpu_timer.queries.size()), gpu_timer.queries.data());
+  gpu_timer = gpu_timer_t{};
+}
+
+static int32_t slot_count(const gpu_timer_t& gpu_timer)
+{
+  return static_cast<int32_t>(gpu_timer.queries.size() / 2);
+}
+
+// reads back the oldest pending slot, returns false if wait is false and the
+// result isn't available yet
+static bool resolve_oldest(gpu_timer_t& gpu_timer, const bool wait)
+{
+  const int32_t count = slot_count(gpu_timer);
+  const int32_t oldest = (gpu_timer.slot - gpu_timer.pending + count) % count;
+  const uint32_t begin_query = gpu_timer.queries[oldest * 2];
+  const uint32_t end_query = gpu_timer.queries[oldest * 2 + 1];
+  if (!wait) {
+    // the end timestamp completes after the begin one
+    uint32_t available = GL_FALSE;
+    glGetQueryObjectuiv(end_query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+      return false;
+    }
+  }
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  glGetQueryObjectui64v(begin_query, GL_QUERY_RESULT, &begin);
+  glGetQueryObjectui64v(end_query, GL_QUERY_RESULT, &end);
+  gpu_timer.time = static_cast<float>(end - begin) * 1e-9f;
+  gpu_timer.total_time += gpu_timer.time;
+  gpu_timer.sample_count++;
+  if (gpu_timer.keep_results) {
+    gpu_timer.results.push_back(gpu_timer.time);
+  }
+  gpu_timer.pending--;
+  return true;
+}
+
+void begin_gpu_timer(gpu_timer_t& gpu_timer)
+{
+  if (gpu_timer.pending == slot_count(gpu_timer)) {
+    resolve_oldest(gpu_timer, true);
+  }
+  glQueryCounter(gpu_timer.queries[gpu_timer.slot * 2], GL_TIMESTAMP);
+}
+
+void end_gpu_timer(gpu_timer_t& gpu_timer)
+{
+  glQueryCounter(gpu_timer.queries[gpu_timer.slot * 2 + 1], GL_TIMESTAMP);
+  gpu_timer.slot = (gpu_timer.slot + 1) % slot_count(gpu_timer);
+  gpu_timer.pending++;
+  while (gpu_timer.pending > 0 && resolve_oldest(gpu_timer, false)) {
+  }
+}
+
+void flush_gpu_timer(gpu_timer_t& gpu_timer)
+{
+  while (gpu_timer.pending > 0) {
+    resolve_oldest(gpu_timer, true);
+  }
+}
+
+float gpu_timer_mean(const gpu_timer_t& gpu_timer)
+{
+  return gpu_timer.sample_count > 0
+         ? static_cast<float>(gpu_timer.total_time / gpu_timer.sample_count)
+         : 0.0f;
+}
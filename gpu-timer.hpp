@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// gpu time of a span of commands measured with a pair of timestamp queries,
+// a ring of pairs (one per frame in flight) is kept so results are read back
+// a few frames later once available instead of stalling the pipeline
+struct gpu_timer_t
+{
+  std::vector<uint32_t> queries; // begin/end timestamp query per slot
+  int32_t slot = 0; // next slot to write
+  int32_t pending = 0; // slots written but not yet read back
+  float time = 0.0f; // seconds, most recent result
+  double total_time = 0.0; // seconds, sum of every result
+  int64_t sample_count = 0;
+  bool keep_results = false; // append every result to results
+  std::vector<float> results; // seconds, in the order the spans were timed
+};
+
+gpu_timer_t create_gpu_timer(int32_t latency = 4);
+void destroy_gpu_timer(gpu_timer_t& gpu_timer);
+
+// commands issued between begin and end are timed, results that became
+// available are read back at end (blocks only if every slot is in flight)
+void begin_gpu_timer(gpu_timer_t& gpu_timer);
+void end_gpu_timer(gpu_timer_t& gpu_timer);
+
+// waits for every pending result, for when all timings are needed now
+void flush_gpu_timer(gpu_timer_t& gpu_timer);
+
+// mean over every result so far in seconds
+float gpu_timer_mean(const gpu_timer_t& gpu_timer);
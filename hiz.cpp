@@ -0,0 +1,162 @@
+#include "hiz.hpp"
+
+#include "gl-state.hpp"
+#include "shader.hpp"
+
+#include <glad/gl.h>
+
+#include <algorithm>
+
+const char* const g_hiz_copy_compute_shader_source =
+  R"(#version 460 core
+layout (local_size_x = 8, local_size_y = 8) in;
+layout (r32f, binding = 0) writeonly uniform image2D destination_level;
+uniform sampler2D depth;
+uniform ivec2 size; // rendered area
+void main()
+{
+  const ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, size))) {
+    return;
+  }
+  imageStore(destination_level, texel, vec4(texelFetch(depth, texel, 0).r));
+})";
+
+const char* const g_hiz_downsample_compute_shader_source =
+  R"(#version 460 core
+layout (local_size_x = 8, local_size_y = 8) in;
+layout (r32f, binding = 0) readonly uniform image2D source_level;
+layout (r32f, binding = 1) writeonly uniform image2D destination_level;
+uniform bool reverse_z;
+uniform ivec2 source_size; // area of source_level in use
+float farthest(const float lhs, const float rhs)
+{
+  return reverse_z ? min(lhs, rhs) : max(lhs, rhs);
+}
+void main()
+{
+  const ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  const ivec2 destination_size = max(source_size / 2, ivec2(1));
+  if (any(greaterThanEqual(texel, destination_size))) {
+    return;
+  }
+  // the last row/column of an odd sized level folds into the last texel of
+  // the next level so no depth is missed
+  const ivec2 first = texel * 2;
+  const ivec2 odd =
+    ivec2(equal(texel, destination_size - 1)) * (source_size & 1);
+  const ivec2 last = min(first + 1 + odd, source_size - 1);
+  float depth = imageLoad(source_level, first).r;
+  for (int y = first.y; y <= last.y; ++y) {
+    for (int x = first.x; x <= last.x; ++x) {
+      depth = farthest(depth, imageLoad(source_level, ivec2(x, y)).r);
+    }
+  }
+  imageStore(destination_level, texel, vec4(depth));
+})";
+
+static int32_t mip_count(const int32_t width, const int32_t height)
+{
+  int32_t count = 1;
+  for (int32_t size = std::max(width, height); size > 1; size /= 2) {
+    count++;
+  }
+  return count;
+}
+
+static uint32_t group_count(const int32_t size)
+{
+  return (size + 7) / 8;
+}
+
+static void allocate_texture(
+  hiz_t& hiz, const int32_t width, const int32_t height)
+{
+  hiz.width = width;
+  hiz.height = height;
+  hiz.mip_count = mip_count(width, height);
+
+  glGenTextures(1, &hiz.texture);
+  gl_state_bind_texture(GL_TEXTURE_2D, hiz.texture);
+  glTexStorage2D(GL_TEXTURE_2D, hiz.mip_count, GL_R32F, width, height);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+}
+
+hiz_t create_hiz(const int32_t width, const int32_t height)
+{
+  hiz_t hiz;
+  hiz.copy_program = create_compute_shader(g_hiz_copy_compute_shader_source);
+  hiz.downsample_program =
+    create_compute_shader(g_hiz_downsample_compute_shader_source);
+  hiz.reverse_z_loc =
+    shader_uniform_location(hiz.downsample_program, "reverse_z");
+  hiz.copy_size_loc = shader_uniform_location(hiz.copy_program, "size");
+  hiz.source_size_loc =
+    shader_uniform_location(hiz.downsample_program, "source_size");
+
+  allocate_texture(hiz, width, height);
+
+  return hiz;
+}
+
+void destroy_hiz(hiz_t& hiz)
+{
+  gl_state_delete_textures(1, &hiz.texture);
+  destroy_shader(hiz.downsample_program);
+  destroy_shader(hiz.copy_program);
+  hiz = hiz_t{};
+}
+
+void resize_hiz(hiz_t& hiz, const int32_t width, const int32_t height)
+{
+  if (width == hiz.width && height == hiz.height) {
+    return;
+  }
+  gl_state_delete_textures(1, &hiz.texture);
+  allocate_texture(hiz, width, height);
+  hiz.valid = false;
+}
+
+void build_hiz(
+  hiz_t& hiz, const uint32_t depth_texture, const int32_t render_width,
+  const int32_t render_height, const as::mat4& view_projection,
+  const bool reverse_z)
+{
+  hiz.render_width = std::clamp(render_width, 1, hiz.width);
+  hiz.render_height = std::clamp(render_height, 1, hiz.height);
+  hiz.render_mip_count = mip_count(hiz.render_width, hiz.render_height);
+
+  gl_state_use_program(hiz.copy_program.id);
+  glUniform2i(hiz.copy_size_loc, hiz.render_width, hiz.render_height);
+  gl_state_active_texture(GL_TEXTURE0);
+  gl_state_bind_texture(GL_TEXTURE_2D, depth_texture);
+  glBindImageTexture(0, hiz.texture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+  glDispatchCompute(
+    group_count(hiz.render_width), group_count(hiz.render_height), 1);
+
+  gl_state_use_program(hiz.downsample_program.id);
+  glUniform1i(hiz.reverse_z_loc, reverse_z);
+  for (int32_t level = 1; level < hiz.render_mip_count; ++level) {
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    glUniform2i(
+      hiz.source_size_loc, std::max(hiz.render_width >> (level - 1), 1),
+      std::max(hiz.render_height >> (level - 1), 1));
+    glBindImageTexture(
+      0, hiz.texture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(
+      1, hiz.texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glDispatchCompute(
+      group_count(std::max(hiz.render_width >> level, 1)),
+      group_count(std::max(hiz.render_height >> level, 1)), 1);
+  }
+
+  // the cull pass reads the pyramid with texelFetch
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+
+  hiz.view_projection = view_projection;
+  hiz.reverse_z = reverse_z;
+  hiz.valid = true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <as/as-math-ops.hpp>
+
+#include <cstdint>
+
+// hierarchical z, a mip chain of the depth buffer where each texel holds the
+// farthest depth of the texels below it (max for normal depth, min for
+// reverse z), built at the end of a frame and used by the next frame's cull
+// pass to reject instances that were completely hidden
+// with dynamic resolution only the rendered area of the depth buffer is
+// used, the pyramid is built from that area in the corner of each level
+struct hiz_t
+{
+  shader_program_t copy_program;
+  shader_program_t downsample_program;
+  uint32_t texture = 0;
+  int32_t reverse_z_loc = -1;
+  int32_t copy_size_loc = -1;
+  int32_t source_size_loc = -1;
+  int32_t width = 0;
+  int32_t height = 0;
+  int32_t mip_count = 0;
+  // area of level 0 the pyramid was built from and its levels down to 1x1
+  int32_t render_width = 0;
+  int32_t render_height = 0;
+  int32_t render_mip_count = 0;
+  // camera and depth convention the pyramid was built with
+  as::mat4 view_projection;
+  bool reverse_z = false;
+  // cleared when the pyramid no longer matches the scene (e.g. new layout)
+  bool valid = false;
+};
+
+hiz_t create_hiz(int32_t width, int32_t height);
+void destroy_hiz(hiz_t& hiz);
+// reallocates the pyramid (invalidating it) to follow the depth buffer size
+void resize_hiz(hiz_t& hiz, int32_t width, int32_t height);
+
+// depth_texture must match the size the pyramid was created with, the
+// pyramid is built from its render_width by render_height corner (what
+// view_projection was rendered to)
+void build_hiz(
+  hiz_t& hiz, uint32_t depth_texture, int32_t render_width,
+  int32_t render_height, const as::mat4& view_projection, bool reverse_z);
@@ -94,6 +94,7 @@
 #include "imgui.h"
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
+#include <chrono>
 #if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
 #include <stddef.h>     // intptr_t
 #else
@@ -167,11 +168,27 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ has texture swizzles, used to sample a single channel font atlas as (1,1,1,alpha)
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_3)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
 // Desktop GL 3.1+ has GL_PRIMITIVE_RESTART state
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_1)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 4.4+ has glBufferStorage() with persistent mapping
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#define IMGUI_IMPL_OPENGL_RING_REGIONS  3   // Frames the GPU may still be reading from the ring
+#endif
+
+// Desktop GL 4.5+ has direct state access, used to build the VAO once instead of every frame
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_5)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -186,12 +203,30 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// State changes and state backup queries go through the application's state cache when one is set (see ImGui_ImplOpenGL3_SetStateCache())
+#define GL_STATE(_FUNC, _ARGS)  (bd->StateCache._FUNC != nullptr ? bd->StateCache._FUNC _ARGS : gl##_FUNC _ARGS)
+
+// Persistent VAO, one per GL context as VAOs are not shared among contexts
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+struct ImGui_ImplOpenGL3_VertexArray
+{
+    void*           ContextKey;              // Value returned by the current context function (nullptr if none was set)
+    GLuint          Handle;
+    GLuint          VboHandle, ElementsHandle; // Buffers currently attached to the VAO
+};
+#endif
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
     GLuint          GlVersion;               // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
     char            GlslVersionString[32];   // Specified by user or detected based on compile time GL settings.
     GLuint          FontTexture;
+    bool            UseAlpha8FontsTexture;   // Requested format, applied the next time the fonts texture is created
+    bool            FontTextureIsAlpha8;     // Format of FontTexture
+    int             FontTextureSize;         // In bytes
+    float           FontTextureConvertTime;  // In milliseconds, atlas pixels to the texture format
+    float           FontTextureUploadTime;   // In milliseconds, until the GPU has the texture
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
@@ -203,6 +238,22 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    ImGui_ImplOpenGL3_StateCache StateCache; // Functions left to nullptr call GL directly
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bool            UsePersistentBuffers;    // Stream all command lists into the persistently mapped ring below
+    GLuint          RingVboHandle, RingElementsHandle;
+    ImDrawVert*     RingVtxMapped;
+    ImDrawIdx*      RingIdxMapped;
+    int             RingVtxCapacity;         // Per region
+    int             RingIdxCapacity;
+    int             RingRegion;
+    GLsync          RingFences[IMGUI_IMPL_OPENGL_RING_REGIONS];
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    bool            UsePersistentVertexArrays; // Keep the VAO across frames instead of recreating it in every RenderDrawData call
+    void*           (*GetCurrentContextFn)();
+    ImVector<ImGui_ImplOpenGL3_VertexArray> VertexArrays;
+#endif
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -238,6 +289,129 @@ struct ImGui_ImplOpenGL3_VtxAttribState
 };
 #endif
 
+// Persistently mapped vertex/index ring, split in one region per frame in flight and guarded by fences
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void ImGui_ImplOpenGL3_WaitRingFence(GLsync& fence)
+{
+    if (fence == nullptr)
+        return;
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+static void ImGui_ImplOpenGL3_DestroyRing()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    for (GLsync& fence : bd->RingFences)
+        ImGui_ImplOpenGL3_WaitRingFence(fence);
+    // Deleting a mapped buffer implicitly unmaps it
+    if (bd->RingVboHandle)      { GL_STATE(DeleteBuffers, (1, &bd->RingVboHandle)); bd->RingVboHandle = 0; }
+    if (bd->RingElementsHandle) { GL_STATE(DeleteBuffers, (1, &bd->RingElementsHandle)); bd->RingElementsHandle = 0; }
+    bd->RingVtxMapped = nullptr;
+    bd->RingIdxMapped = nullptr;
+    bd->RingVtxCapacity = bd->RingIdxCapacity = 0;
+    bd->RingRegion = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    // Buffer names may be reused by the next ring, make sure the persistent VAOs attach the new buffers
+    for (ImGui_ImplOpenGL3_VertexArray& vertex_array : bd->VertexArrays)
+        vertex_array.VboHandle = vertex_array.ElementsHandle = 0;
+#endif
+}
+
+// Binds GL_ARRAY_BUFFER, caller is expected to restore it
+static void ImGui_ImplOpenGL3_CreateRing(int vtx_capacity, int idx_capacity)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_DestroyRing();
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr vtx_size = (GLsizeiptr)vtx_capacity * IMGUI_IMPL_OPENGL_RING_REGIONS * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)idx_capacity * IMGUI_IMPL_OPENGL_RING_REGIONS * (int)sizeof(ImDrawIdx);
+    glGenBuffers(1, &bd->RingVboHandle);
+    glGenBuffers(1, &bd->RingElementsHandle);
+    // The target used to allocate doesn't matter, GL_ARRAY_BUFFER avoids touching the element binding of the bound VAO
+    GL_CALL(GL_STATE(BindBuffer, (GL_ARRAY_BUFFER, bd->RingVboHandle)));
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, vtx_size, nullptr, flags));
+    bd->RingVtxMapped = (ImDrawVert*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vtx_size, flags);
+    GL_CALL(GL_STATE(BindBuffer, (GL_ARRAY_BUFFER, bd->RingElementsHandle)));
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, idx_size, nullptr, flags));
+    bd->RingIdxMapped = (ImDrawIdx*)glMapBufferRange(GL_ARRAY_BUFFER, 0, idx_size, flags);
+    bd->RingVtxCapacity = vtx_capacity;
+    bd->RingIdxCapacity = idx_capacity;
+}
+#endif
+
+// Persistent VAOs (Desktop GL 4.5+): the attribute formats are specified once with direct state access and only the
+// buffer attachments are updated when the buffers change (e.g. switching to the ring or growing it).
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+static GLuint ImGui_ImplOpenGL3_GetVertexArray()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    void* context_key = bd->GetCurrentContextFn ? bd->GetCurrentContextFn() : nullptr;
+
+    ImGui_ImplOpenGL3_VertexArray* vertex_array = nullptr;
+    for (ImGui_ImplOpenGL3_VertexArray& cached : bd->VertexArrays)
+        if (cached.ContextKey == context_key)
+        {
+            vertex_array = &cached;
+            break;
+        }
+    if (vertex_array == nullptr)
+    {
+        ImGui_ImplOpenGL3_VertexArray new_vertex_array = {};
+        new_vertex_array.ContextKey = context_key;
+        GL_CALL(glCreateVertexArrays(1, &new_vertex_array.Handle));
+        const GLuint vao = new_vertex_array.Handle;
+        GL_CALL(glEnableVertexArrayAttrib(vao, bd->AttribLocationVtxPos));
+        GL_CALL(glEnableVertexArrayAttrib(vao, bd->AttribLocationVtxUV));
+        GL_CALL(glEnableVertexArrayAttrib(vao, bd->AttribLocationVtxColor));
+        GL_CALL(glVertexArrayAttribFormat(vao, bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, IM_OFFSETOF(ImDrawVert, pos)));
+        GL_CALL(glVertexArrayAttribFormat(vao, bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, IM_OFFSETOF(ImDrawVert, uv)));
+        GL_CALL(glVertexArrayAttribFormat(vao, bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  IM_OFFSETOF(ImDrawVert, col)));
+        GL_CALL(glVertexArrayAttribBinding(vao, bd->AttribLocationVtxPos, 0));
+        GL_CALL(glVertexArrayAttribBinding(vao, bd->AttribLocationVtxUV, 0));
+        GL_CALL(glVertexArrayAttribBinding(vao, bd->AttribLocationVtxColor, 0));
+        bd->VertexArrays.push_back(new_vertex_array);
+        vertex_array = &bd->VertexArrays.back();
+    }
+
+    GLuint vbo = bd->VboHandle;
+    GLuint ebo = bd->ElementsHandle;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentBuffers)
+    {
+        vbo = bd->RingVboHandle;
+        ebo = bd->RingElementsHandle;
+    }
+#endif
+    // DSA attaches fail with GL_INVALID_OPERATION for names that aren't buffer objects yet (generated but never bound),
+    // only remember a buffer once it was attached so a failed attach is retried
+    if (vertex_array->VboHandle != vbo && glIsBuffer(vbo))
+    {
+        GL_CALL(glVertexArrayVertexBuffer(vertex_array->Handle, 0, vbo, 0, sizeof(ImDrawVert)));
+        vertex_array->VboHandle = vbo;
+    }
+    if (vertex_array->ElementsHandle != ebo && glIsBuffer(ebo))
+    {
+        GL_CALL(glVertexArrayElementBuffer(vertex_array->Handle, ebo));
+        vertex_array->ElementsHandle = ebo;
+    }
+    return vertex_array->Handle;
+}
+
+// VAOs can only be deleted from their own context, the ones of other contexts are released along with their context
+static void ImGui_ImplOpenGL3_DestroyVertexArrays()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    void* context_key = bd->GetCurrentContextFn ? bd->GetCurrentContextFn() : nullptr;
+    for (ImGui_ImplOpenGL3_VertexArray& vertex_array : bd->VertexArrays)
+        if (vertex_array.ContextKey == context_key)
+            GL_STATE(DeleteVertexArrays, (1, &vertex_array.Handle));
+    bd->VertexArrays.clear();
+}
+#endif
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -316,6 +490,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 
     // Detect extensions we support
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    bd->UsePersistentVertexArrays = (bd->GlVersion >= 450);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -349,6 +526,79 @@ void    ImGui_ImplOpenGL3_NewFrame()
 
     if (!bd->ShaderHandle)
         ImGui_ImplOpenGL3_CreateDeviceObjects();
+    else if (bd->FontTexture && bd->FontTextureIsAlpha8 != bd->UseAlpha8FontsTexture)
+    {
+        // Recreated here as the previous frame's draw data may still reference the old texture
+        ImGui_ImplOpenGL3_DestroyFontsTexture();
+        ImGui_ImplOpenGL3_CreateFontsTexture();
+    }
+}
+
+bool    ImGui_ImplOpenGL3_SetUsePersistentBuffers(bool use_persistent_buffers)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bd->UsePersistentBuffers = use_persistent_buffers && bd->GlVersion >= 440;
+    return bd->UsePersistentBuffers == use_persistent_buffers;
+#else
+    (void)bd;
+    return !use_persistent_buffers;
+#endif
+}
+
+bool    ImGui_ImplOpenGL3_SetUsePersistentVertexArrays(bool use_persistent_vertex_arrays)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    bd->UsePersistentVertexArrays = use_persistent_vertex_arrays && bd->GlVersion >= 450;
+    return bd->UsePersistentVertexArrays == use_persistent_vertex_arrays;
+#else
+    (void)bd;
+    return !use_persistent_vertex_arrays;
+#endif
+}
+
+bool    ImGui_ImplOpenGL3_SetUseAlpha8FontsTexture(bool use_alpha8_fonts_texture)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->UseAlpha8FontsTexture = use_alpha8_fonts_texture && bd->GlVersion >= 330;
+#endif
+    return bd->UseAlpha8FontsTexture == use_alpha8_fonts_texture;
+}
+
+void    ImGui_ImplOpenGL3_GetFontsTextureStats(int* out_size_in_bytes, float* out_convert_time_ms, float* out_upload_time_ms)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (out_size_in_bytes) *out_size_in_bytes = bd->FontTexture ? bd->FontTextureSize : 0;
+    if (out_convert_time_ms) *out_convert_time_ms = bd->FontTexture ? bd->FontTextureConvertTime : 0.0f;
+    if (out_upload_time_ms) *out_upload_time_ms = bd->FontTexture ? bd->FontTextureUploadTime : 0.0f;
+}
+
+void    ImGui_ImplOpenGL3_SetStateCache(const ImGui_ImplOpenGL3_StateCache* state_cache)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (state_cache != nullptr)
+        bd->StateCache = *state_cache;
+    else
+        memset((void*)&bd->StateCache, 0, sizeof(bd->StateCache));
+}
+
+void    ImGui_ImplOpenGL3_SetCurrentContextFn(void* (*get_current_context)())
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    bd->GetCurrentContextFn = get_current_context;
+#else
+    (void)bd;
+    (void)get_current_context;
+#endif
 }
 
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
@@ -356,19 +606,19 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    GL_STATE(Enable, (GL_BLEND));
+    GL_STATE(BlendEquation, (GL_FUNC_ADD));
+    GL_STATE(BlendFuncSeparate, (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+    GL_STATE(Disable, (GL_CULL_FACE));
+    GL_STATE(Disable, (GL_DEPTH_TEST));
+    GL_STATE(Disable, (GL_STENCIL_TEST));
+    GL_STATE(Enable, (GL_SCISSOR_TEST));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
     if (bd->GlVersion >= 310)
-        glDisable(GL_PRIMITIVE_RESTART);
+        GL_STATE(Disable, (GL_PRIMITIVE_RESTART));
 #endif
 #ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GL_STATE(PolygonMode, (GL_FRONT_AND_BACK, GL_FILL));
 #endif
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
@@ -376,7 +626,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     bool clip_origin_lower_left = true;
     if (bd->HasClipOrigin)
     {
-        GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
+        GLenum current_clip_origin = 0; GL_STATE(GetIntegerv, (GL_CLIP_ORIGIN, (GLint*)&current_clip_origin));
         if (current_clip_origin == GL_UPPER_LEFT)
             clip_origin_lower_left = false;
     }
@@ -384,7 +634,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 
     // Setup viewport, orthographic projection matrix
     // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
+    GL_CALL(GL_STATE(Viewport, (0, 0, (GLsizei)fb_width, (GLsizei)fb_height)));
     float L = draw_data->DisplayPos.x;
     float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
     float T = draw_data->DisplayPos.y;
@@ -399,23 +649,37 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(bd->ShaderHandle);
+    GL_STATE(UseProgram, (bd->ShaderHandle));
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
-        glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
+        GL_STATE(BindSampler, (0, 0)); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
 #endif
 
     (void)vertex_array_object;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(vertex_array_object);
+    GL_STATE(BindVertexArray, (vertex_array_object));
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
-    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    GLuint vbo = bd->VboHandle;
+    GLuint ebo = bd->ElementsHandle;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentBuffers)
+    {
+        vbo = bd->RingVboHandle;
+        ebo = bd->RingElementsHandle;
+    }
+#endif
+    GL_CALL(GL_STATE(BindBuffer, (GL_ARRAY_BUFFER, vbo))); // Still needed for the glBufferData() uploads
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    // The persistent VAO already holds the element buffer and attribute setup
+    if (bd->UsePersistentVertexArrays)
+        return;
+#endif
+    GL_CALL(GL_STATE(BindBuffer, (GL_ELEMENT_ARRAY_BUFFER, ebo)));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
@@ -438,51 +702,95 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+    GLenum last_active_texture; GL_STATE(GetIntegerv, (GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture));
+    GL_STATE(ActiveTexture, (GL_TEXTURE0));
+    GLuint last_program; GL_STATE(GetIntegerv, (GL_CURRENT_PROGRAM, (GLint*)&last_program));
+    GLuint last_texture; GL_STATE(GetIntegerv, (GL_TEXTURE_BINDING_2D, (GLint*)&last_texture));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
+    GLuint last_sampler; if (bd->GlVersion >= 330) { GL_STATE(GetIntegerv, (GL_SAMPLER_BINDING, (GLint*)&last_sampler)); } else { last_sampler = 0; }
 #endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+    GLuint last_array_buffer; GL_STATE(GetIntegerv, (GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer));
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+    GLint last_element_array_buffer; GL_STATE(GetIntegerv, (GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer));
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
 #endif
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+    GLuint last_vertex_array_object; GL_STATE(GetIntegerv, (GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object));
 #endif
 #ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+    GLint last_polygon_mode[2]; GL_STATE(GetIntegerv, (GL_POLYGON_MODE, last_polygon_mode));
+#endif
+    GLint last_viewport[4]; GL_STATE(GetIntegerv, (GL_VIEWPORT, last_viewport));
+    GLint last_scissor_box[4]; GL_STATE(GetIntegerv, (GL_SCISSOR_BOX, last_scissor_box));
+    GLenum last_blend_src_rgb; GL_STATE(GetIntegerv, (GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb));
+    GLenum last_blend_dst_rgb; GL_STATE(GetIntegerv, (GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb));
+    GLenum last_blend_src_alpha; GL_STATE(GetIntegerv, (GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha));
+    GLenum last_blend_dst_alpha; GL_STATE(GetIntegerv, (GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha));
+    GLenum last_blend_equation_rgb; GL_STATE(GetIntegerv, (GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb));
+    GLenum last_blend_equation_alpha; GL_STATE(GetIntegerv, (GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha));
+    GLboolean last_enable_blend = GL_STATE(IsEnabled, (GL_BLEND));
+    GLboolean last_enable_cull_face = GL_STATE(IsEnabled, (GL_CULL_FACE));
+    GLboolean last_enable_depth_test = GL_STATE(IsEnabled, (GL_DEPTH_TEST));
+    GLboolean last_enable_stencil_test = GL_STATE(IsEnabled, (GL_STENCIL_TEST));
+    GLboolean last_enable_scissor_test = GL_STATE(IsEnabled, (GL_SCISSOR_TEST));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? GL_STATE(IsEnabled, (GL_PRIMITIVE_RESTART)) : GL_FALSE;
 #endif
 
     // Setup desired GL state
+    // Persistent buffers: copy every command list into this frame's region of the ring in a single pass, no driver
+    // copies are involved and each draw addresses its data with base vertex/index offsets into the region.
+    // Otherwise each command list is uploaded separately in the loop below.
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    const bool use_persistent_buffers = bd->UsePersistentBuffers;
+    int ring_vtx_base = 0;
+    int ring_idx_base = 0;
+    if (use_persistent_buffers)
+    {
+        if (draw_data->TotalVtxCount > bd->RingVtxCapacity || draw_data->TotalIdxCount > bd->RingIdxCapacity)
+        {
+            // Grow geometrically, this waits for the GPU to finish with every region
+            int vtx_capacity = bd->RingVtxCapacity ? bd->RingVtxCapacity : (1 << 16);
+            int idx_capacity = bd->RingIdxCapacity ? bd->RingIdxCapacity : (1 << 17);
+            while (vtx_capacity < draw_data->TotalVtxCount) vtx_capacity *= 2;
+            while (idx_capacity < draw_data->TotalIdxCount) idx_capacity *= 2;
+            ImGui_ImplOpenGL3_CreateRing(vtx_capacity, idx_capacity);
+        }
+        ImGui_ImplOpenGL3_WaitRingFence(bd->RingFences[bd->RingRegion]);
+        ring_vtx_base = bd->RingRegion * bd->RingVtxCapacity;
+        ring_idx_base = bd->RingRegion * bd->RingIdxCapacity;
+        ImDrawVert* vtx_dst = bd->RingVtxMapped + ring_vtx_base;
+        ImDrawIdx* idx_dst = bd->RingIdxMapped + ring_idx_base;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtx_dst += cmd_list->VtxBuffer.Size;
+            idx_dst += cmd_list->IdxBuffer.Size;
+        }
+    }
+#endif
+
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
+    // unless persistent VAOs are enabled, which keep one VAO per context and are fetched after the ring may have been recreated above.
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
     GLuint vertex_array_object = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    const bool use_persistent_vertex_array = bd->UsePersistentVertexArrays;
+    if (use_persistent_vertex_array)
+        vertex_array_object = ImGui_ImplOpenGL3_GetVertexArray();
+    else
+#endif
+    {
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
+    }
+
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
     // Will project scissor/clipping rectangles into framebuffer space
@@ -500,6 +808,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - OpenGL drivers are in a very sorry state in 2022, for now we are switching code path based on vendors.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (use_persistent_buffers)
+        {
+            // Already copied into the ring
+        }
+        else
+#endif
         if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
@@ -542,10 +857,15 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                GL_CALL(GL_STATE(Scissor, ((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y))));
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                GL_CALL(GL_STATE(BindTexture, (GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID())));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+                if (use_persistent_buffers)
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((ring_idx_base + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(ring_vtx_base + pcmd->VtxOffset)));
+                else
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
@@ -554,47 +874,65 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        ring_vtx_base += cmd_list->VtxBuffer.Size;
+        ring_idx_base += cmd_list->IdxBuffer.Size;
+#endif
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // Fence this frame's region so it isn't overwritten while the GPU still reads from it
+    if (use_persistent_buffers)
+    {
+        bd->RingFences[bd->RingRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->RingRegion = (bd->RingRegion + 1) % IMGUI_IMPL_OPENGL_RING_REGIONS;
+    }
+#endif
+
     // Destroy the temporary VAO
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    if (!use_persistent_vertex_array)
+#endif
+    {
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+        GL_CALL(GL_STATE(DeleteVertexArrays, (1, &vertex_array_object)));
 #endif
+    }
 
     // Restore modified GL state
-    glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
+    GL_STATE(UseProgram, (last_program));
+    GL_STATE(BindTexture, (GL_TEXTURE_2D, last_texture));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
-        glBindSampler(0, last_sampler);
+        GL_STATE(BindSampler, (0, last_sampler));
 #endif
-    glActiveTexture(last_active_texture);
+    GL_STATE(ActiveTexture, (last_active_texture));
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
+    GL_STATE(BindVertexArray, (last_vertex_array_object));
 #endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+    GL_STATE(BindBuffer, (GL_ARRAY_BUFFER, last_array_buffer));
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
+    GL_STATE(BindBuffer, (GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer));
     last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
     last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
     last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
 #endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+    GL_STATE(BlendEquationSeparate, (last_blend_equation_rgb, last_blend_equation_alpha));
+    GL_STATE(BlendFuncSeparate, (last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha));
+    if (last_enable_blend) GL_STATE(Enable, (GL_BLEND)); else GL_STATE(Disable, (GL_BLEND));
+    if (last_enable_cull_face) GL_STATE(Enable, (GL_CULL_FACE)); else GL_STATE(Disable, (GL_CULL_FACE));
+    if (last_enable_depth_test) GL_STATE(Enable, (GL_DEPTH_TEST)); else GL_STATE(Disable, (GL_DEPTH_TEST));
+    if (last_enable_stencil_test) GL_STATE(Enable, (GL_STENCIL_TEST)); else GL_STATE(Disable, (GL_STENCIL_TEST));
+    if (last_enable_scissor_test) GL_STATE(Enable, (GL_SCISSOR_TEST)); else GL_STATE(Disable, (GL_SCISSOR_TEST));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+    if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) GL_STATE(Enable, (GL_PRIMITIVE_RESTART)); else GL_STATE(Disable, (GL_PRIMITIVE_RESTART)); }
 #endif
 
 #ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+    GL_STATE(PolygonMode, (GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]));
 #endif
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    GL_STATE(Viewport, (last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]));
+    GL_STATE(Scissor, (last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]));
     (void)bd; // Not all compilation paths use this
 }
 
@@ -604,12 +942,25 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Build texture atlas
+    // Rasterizing the glyphs costs the same in both formats, so it's done before timing starts. Building also drops the pixels a previous
+    // GetTexDataAsRGBA32() converted and cached, so the RGBA conversion is timed every time the texture is created and not just the first.
+    io.Fonts->Build();
+    const auto convert_begin = std::chrono::steady_clock::now();
+    const bool use_alpha8 = bd->UseAlpha8FontsTexture;
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    if (use_alpha8)
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);   // Load as 8-bit coverage, expanded back to (1,1,1,alpha) by the texture swizzle below so the shader and blending are unchanged. Atlases with colored custom rects need the RGBA path.
+    else
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+
+    bd->FontTextureConvertTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - convert_begin).count();
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
+    // glTexImage2D() can return before the upload is done, the GPU is drained first so only the upload is waited for by the second glFinish()
+    GL_CALL(glFinish());
+    const auto upload_begin = std::chrono::steady_clock::now();
     GLint last_texture;
     GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
     GL_CALL(glGenTextures(1, &bd->FontTexture));
@@ -618,8 +969,26 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
     GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (use_alpha8)
+    {
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+        GLint last_unpack_alignment; glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1)); // Rows are tightly packed single bytes
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
+    }
+    else
 #endif
     GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    GL_CALL(glFinish());
+    bd->FontTextureUploadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - upload_begin).count();
+    bd->FontTextureIsAlpha8 = use_alpha8;
+    bd->FontTextureSize = width * height * (use_alpha8 ? 1 : 4);
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -636,7 +1005,7 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->FontTexture)
     {
-        glDeleteTextures(1, &bd->FontTexture);
+        GL_STATE(DeleteTextures, (1, &bd->FontTexture));
         io.Fonts->SetTexID(0);
         bd->FontTexture = 0;
     }
@@ -852,9 +1221,12 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
 
-    // Create buffers
+    // Create buffers, binding a generated name is what creates the buffer object (the persistent VAO attaches them
+    // with DSA before they're first bound for drawing), GL_ARRAY_BUFFER avoids touching the element binding of the bound VAO
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->ElementsHandle);
 
     ImGui_ImplOpenGL3_CreateFontsTexture();
 
@@ -871,9 +1243,16 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
-    if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
-    if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->VboHandle)      { GL_STATE(DeleteBuffers, (1, &bd->VboHandle)); bd->VboHandle = 0; }
+    if (bd->ElementsHandle) { GL_STATE(DeleteBuffers, (1, &bd->ElementsHandle)); bd->ElementsHandle = 0; }
+    if (bd->ShaderHandle)   { GL_STATE(DeleteProgram, (bd->ShaderHandle)); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_DSA
+    // Attribute locations may change when the shader is recreated
+    ImGui_ImplOpenGL3_DestroyVertexArrays();
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    ImGui_ImplOpenGL3_DestroyRing();
+#endif
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
@@ -32,6 +32,53 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Copy all command lists into a single persistently mapped ring buffer each frame instead of uploading them one by one (Desktop GL 4.4+)
+// The glBufferData/glBufferSubData paths remain the fallback. Returns false if the requested mode isn't supported.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetUsePersistentBuffers(bool use_persistent_buffers);
+
+// (Optional) Keep the VAO across frames, built once with direct state access instead of recreated every frame (Desktop GL 4.5+, enabled by default when available).
+// VAOs are not shared among GL contexts: when rendering from several contexts, provide a function returning the current one (e.g. SDL_GL_GetCurrentContext) so one VAO is cached per context.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetUsePersistentVertexArrays(bool use_persistent_vertex_arrays);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetCurrentContextFn(void* (*get_current_context)());
+
+// (Optional) Upload the font atlas as a single channel GL_R8 texture (GetTexDataAsAlpha8) swizzled to (1,1,1,alpha) instead of GL_RGBA (Desktop GL 3.3+).
+// Rendering is unchanged for a quarter of the memory, but colored custom rects in the atlas lose their color. Applied by the next NewFrame().
+// Returns false if the requested mode isn't supported.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetUseAlpha8FontsTexture(bool use_alpha8_fonts_texture);
+// (Optional) Memory used by the fonts texture and the time it took to create it, zero before it is created. The atlas is built (glyphs rasterized)
+// before timing starts so both formats are charged the same: convert is the CPU time getting the pixels in the texture format, upload is the
+// time until the GPU has the texture (the pipeline is drained before and after, so only use it at startup or when toggling the format).
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_GetFontsTextureStats(int* out_size_in_bytes, float* out_convert_time_ms, float* out_upload_time_ms);
+
+// (Optional) Route the state changes and state backup queries made while rendering through an application side state cache, so redundant
+// changes can be skipped and the backup queries answered without a round trip to the driver. Functions are called with the same arguments
+// as their GL counterpart, any left to nullptr calls GL directly. Pass nullptr to go back to calling GL for everything.
+// The cache must see every change made to the state it tracks, including the ones made by the application.
+struct ImGui_ImplOpenGL3_StateCache
+{
+    void            (*GetIntegerv)(unsigned int pname, int* data);
+    unsigned char   (*IsEnabled)(unsigned int cap);
+    void            (*Enable)(unsigned int cap);
+    void            (*Disable)(unsigned int cap);
+    void            (*UseProgram)(unsigned int program);
+    void            (*ActiveTexture)(unsigned int texture);
+    void            (*BindTexture)(unsigned int target, unsigned int texture);
+    void            (*BindSampler)(unsigned int unit, unsigned int sampler);
+    void            (*BindVertexArray)(unsigned int array);
+    void            (*BindBuffer)(unsigned int target, unsigned int buffer);
+    void            (*BlendEquation)(unsigned int mode);
+    void            (*BlendEquationSeparate)(unsigned int mode_rgb, unsigned int mode_alpha);
+    void            (*BlendFuncSeparate)(unsigned int src_rgb, unsigned int dst_rgb, unsigned int src_alpha, unsigned int dst_alpha);
+    void            (*Viewport)(int x, int y, int width, int height);
+    void            (*Scissor)(int x, int y, int width, int height);
+    void            (*PolygonMode)(unsigned int face, unsigned int mode);
+    void            (*DeleteTextures)(int n, const unsigned int* textures);         // Deleted objects are unbound by GL, the cache has to forget them
+    void            (*DeleteBuffers)(int n, const unsigned int* buffers);
+    void            (*DeleteVertexArrays)(int n, const unsigned int* arrays);
+    void            (*DeleteProgram)(unsigned int program);
+};
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetStateCache(const ImGui_ImplOpenGL3_StateCache* state_cache);
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
@@ -92,6 +92,15 @@ struct ImGui_ImplSDL2_Data
     char*           ClipboardTextData;
     bool            MouseCanUseGlobalState;
 
+    // Threaded use (see ImGui_ImplSDL2_SetThreaded()), MouseButtonsDown and these belong to the SDL thread
+    int             AppliedMouseCursor;
+    bool            ClipboardFetched;
+    // and these to the Dear ImGui thread (along with Time and PendingMouseLeaveFrame)
+    int             InputMouseButtonsDown;
+    ImVector<char>  InputClipboardText;
+    ImVector<char>  PendingClipboardText;
+    bool            HasPendingClipboardText;
+
     ImGui_ImplSDL2_Data()   { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -104,6 +113,9 @@ static ImGui_ImplSDL2_Data* ImGui_ImplSDL2_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplSDL2_Data*)ImGui::GetIO().BackendPlatformUserData : nullptr;
 }
 
+// Threaded use: the backend data as seen from the SDL thread, which doesn't access the Dear ImGui context
+static ImGui_ImplSDL2_Data* g_ThreadedBackendData = nullptr;
+
 // Functions
 static const char* ImGui_ImplSDL2_GetClipboardText(void*)
 {
@@ -428,6 +440,8 @@ void ImGui_ImplSDL2_Shutdown()
     for (ImGuiMouseCursor cursor_n = 0; cursor_n < ImGuiMouseCursor_COUNT; cursor_n++)
         SDL_FreeCursor(bd->MouseCursors[cursor_n]);
 
+    if (g_ThreadedBackendData == bd)
+        g_ThreadedBackendData = nullptr;
     io.BackendPlatformName = nullptr;
     io.BackendPlatformUserData = nullptr;
     IM_DELETE(bd);
@@ -485,23 +499,16 @@ static void ImGui_ImplSDL2_UpdateMouseCursor()
     }
 }
 
-static void ImGui_ImplSDL2_UpdateGamepads()
+// Reads the first gamepad into add_key (called as io.AddKeyAnalogEvent() would be), returns false if there is none
+static bool ImGui_ImplSDL2_ReadGamepad(void (*add_key)(void* user_data, ImGuiKey key, bool down, float value), void* user_data)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    if ((io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) == 0) // FIXME: Technically feeding gamepad shouldn't depend on this now that they are regular inputs.
-        return;
-
-    // Get gamepad
-    io.BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
     SDL_GameController* game_controller = SDL_GameControllerOpen(0);
     if (!game_controller)
-        return;
-    io.BackendFlags |= ImGuiBackendFlags_HasGamepad;
+        return false;
 
-    // Update gamepad inputs
     #define IM_SATURATE(V)                      (V < 0.0f ? 0.0f : V > 1.0f ? 1.0f : V)
-    #define MAP_BUTTON(KEY_NO, BUTTON_NO)       { io.AddKeyEvent(KEY_NO, SDL_GameControllerGetButton(game_controller, BUTTON_NO) != 0); }
-    #define MAP_ANALOG(KEY_NO, AXIS_NO, V0, V1) { float vn = (float)(SDL_GameControllerGetAxis(game_controller, AXIS_NO) - V0) / (float)(V1 - V0); vn = IM_SATURATE(vn); io.AddKeyAnalogEvent(KEY_NO, vn > 0.1f, vn); }
+    #define MAP_BUTTON(KEY_NO, BUTTON_NO)       { bool down = SDL_GameControllerGetButton(game_controller, BUTTON_NO) != 0; add_key(user_data, KEY_NO, down, down ? 1.0f : 0.0f); }
+    #define MAP_ANALOG(KEY_NO, AXIS_NO, V0, V1) { float vn = (float)(SDL_GameControllerGetAxis(game_controller, AXIS_NO) - V0) / (float)(V1 - V0); vn = IM_SATURATE(vn); add_key(user_data, KEY_NO, vn > 0.1f, vn); }
     const int thumb_dead_zone = 8000;           // SDL_gamecontroller.h suggests using this value.
     MAP_BUTTON(ImGuiKey_GamepadStart,           SDL_CONTROLLER_BUTTON_START);
     MAP_BUTTON(ImGuiKey_GamepadBack,            SDL_CONTROLLER_BUTTON_BACK);
@@ -529,6 +536,20 @@ static void ImGui_ImplSDL2_UpdateGamepads()
     MAP_ANALOG(ImGuiKey_GamepadRStickDown,      SDL_CONTROLLER_AXIS_RIGHTY, +thumb_dead_zone, +32767);
     #undef MAP_BUTTON
     #undef MAP_ANALOG
+    return true;
+}
+
+static void ImGui_ImplSDL2_UpdateGamepads()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if ((io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) == 0) // FIXME: Technically feeding gamepad shouldn't depend on this now that they are regular inputs.
+        return;
+
+    // Get gamepad and update its inputs
+    io.BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
+    const auto add_key = [](void* user_data, ImGuiKey key, bool down, float value) { ((ImGuiIO*)user_data)->AddKeyAnalogEvent(key, down, value); };
+    if (ImGui_ImplSDL2_ReadGamepad(add_key, &io))
+        io.BackendFlags |= ImGuiBackendFlags_HasGamepad;
 }
 
 void ImGui_ImplSDL2_NewFrame()
@@ -569,3 +590,354 @@ void ImGui_ImplSDL2_NewFrame()
     // Update game controllers (if enabled and available)
     ImGui_ImplSDL2_UpdateGamepads();
 }
+
+//-----------------------------------------------------------------------------
+// Threaded use (see imgui_impl_sdl.h)
+//-----------------------------------------------------------------------------
+
+enum ImGui_ImplSDL2_InputType_
+{
+    ImGui_ImplSDL2_InputType_MousePos,
+    ImGui_ImplSDL2_InputType_MouseWheel,
+    ImGui_ImplSDL2_InputType_MouseButton,
+    ImGui_ImplSDL2_InputType_MouseEnter,
+    ImGui_ImplSDL2_InputType_MouseLeave,
+    ImGui_ImplSDL2_InputType_Text,
+    ImGui_ImplSDL2_InputType_Key,
+    ImGui_ImplSDL2_InputType_KeyAnalog,
+    ImGui_ImplSDL2_InputType_Focus,
+};
+
+static ImGui_ImplSDL2_Input ImGui_ImplSDL2_MakeInput(int type)
+{
+    ImGui_ImplSDL2_Input input;
+    memset((void*)&input, 0, sizeof(input));
+    input.Type = type;
+    input.NativeKeycode = -1;
+    return input;
+}
+
+static void ImGui_ImplSDL2_CopyText(ImVector<char>& dst, const char* text)
+{
+    dst.resize((int)strlen(text) + 1);
+    memcpy(dst.Data, text, (size_t)dst.Size);
+}
+
+// The clipboard is read on the SDL thread when it changes and written there with the next outputs
+static const char* ImGui_ImplSDL2_GetThreadedClipboardText(void*)
+{
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    return bd->InputClipboardText.empty() ? "" : bd->InputClipboardText.Data;
+}
+
+static void ImGui_ImplSDL2_SetThreadedClipboardText(void*, const char* text)
+{
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    ImGui_ImplSDL2_CopyText(bd->PendingClipboardText, text);
+    bd->InputClipboardText = bd->PendingClipboardText; // pasting right away gets it back
+    bd->HasPendingClipboardText = true;
+}
+
+void ImGui_ImplSDL2_SetThreaded(bool threaded)
+{
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplSDL2_Init()?");
+    ImGuiIO& io = ImGui::GetIO();
+    io.SetClipboardTextFn = threaded ? ImGui_ImplSDL2_SetThreadedClipboardText : ImGui_ImplSDL2_SetClipboardText;
+    io.GetClipboardTextFn = threaded ? ImGui_ImplSDL2_GetThreadedClipboardText : ImGui_ImplSDL2_GetClipboardText;
+    bd->AppliedMouseCursor = -1;
+    bd->ClipboardFetched = false;
+    g_ThreadedBackendData = threaded ? bd : nullptr;
+}
+
+static void ImGui_ImplSDL2_RecordKey(ImGui_ImplSDL2_Inputs* inputs, ImGuiKey key, bool down, int native_keycode, int native_scancode)
+{
+    ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_Key);
+    input.Key = key;
+    input.Down = down;
+    input.NativeKeycode = native_keycode;
+    input.NativeScancode = native_scancode;
+    inputs->Events.push_back(input);
+}
+
+static void ImGui_ImplSDL2_RecordMousePos(ImGui_ImplSDL2_Inputs* inputs, float x, float y)
+{
+    ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_MousePos);
+    input.X = x;
+    input.Y = y;
+    inputs->Events.push_back(input);
+}
+
+// Same translation as ImGui_ImplSDL2_ProcessEvent()
+void ImGui_ImplSDL2_RecordEvent(const SDL_Event* event, ImGui_ImplSDL2_Inputs* inputs)
+{
+    ImGui_ImplSDL2_Data* bd = g_ThreadedBackendData;
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplSDL2_SetThreaded(true)?");
+
+    switch (event->type)
+    {
+        case SDL_MOUSEMOTION:
+        {
+            ImGui_ImplSDL2_RecordMousePos(inputs, (float)event->motion.x, (float)event->motion.y);
+            break;
+        }
+        case SDL_MOUSEWHEEL:
+        {
+            ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_MouseWheel);
+            input.X = (event->wheel.x > 0) ? 1.0f : (event->wheel.x < 0) ? -1.0f : 0.0f;
+            input.Y = (event->wheel.y > 0) ? 1.0f : (event->wheel.y < 0) ? -1.0f : 0.0f;
+            inputs->Events.push_back(input);
+            break;
+        }
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        {
+            int mouse_button = -1;
+            if (event->button.button == SDL_BUTTON_LEFT) { mouse_button = 0; }
+            if (event->button.button == SDL_BUTTON_RIGHT) { mouse_button = 1; }
+            if (event->button.button == SDL_BUTTON_MIDDLE) { mouse_button = 2; }
+            if (event->button.button == SDL_BUTTON_X1) { mouse_button = 3; }
+            if (event->button.button == SDL_BUTTON_X2) { mouse_button = 4; }
+            if (mouse_button == -1)
+                break;
+            ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_MouseButton);
+            input.Key = mouse_button;
+            input.Down = (event->type == SDL_MOUSEBUTTONDOWN);
+            inputs->Events.push_back(input);
+            bd->MouseButtonsDown = input.Down ? (bd->MouseButtonsDown | (1 << mouse_button)) : (bd->MouseButtonsDown & ~(1 << mouse_button));
+            break;
+        }
+        case SDL_TEXTINPUT:
+        {
+            ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_Text);
+            IM_STATIC_ASSERT(sizeof(input.Text) >= sizeof(event->text.text));
+            memcpy(input.Text, event->text.text, sizeof(event->text.text));
+            input.Text[IM_ARRAYSIZE(input.Text) - 1] = 0;
+            inputs->Events.push_back(input);
+            break;
+        }
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        {
+            const SDL_Keymod sdl_key_mods = (SDL_Keymod)event->key.keysym.mod;
+            ImGui_ImplSDL2_RecordKey(inputs, ImGuiMod_Ctrl, (sdl_key_mods & KMOD_CTRL) != 0, -1, -1);
+            ImGui_ImplSDL2_RecordKey(inputs, ImGuiMod_Shift, (sdl_key_mods & KMOD_SHIFT) != 0, -1, -1);
+            ImGui_ImplSDL2_RecordKey(inputs, ImGuiMod_Alt, (sdl_key_mods & KMOD_ALT) != 0, -1, -1);
+            ImGui_ImplSDL2_RecordKey(inputs, ImGuiMod_Super, (sdl_key_mods & KMOD_GUI) != 0, -1, -1);
+            ImGui_ImplSDL2_RecordKey(
+                inputs, ImGui_ImplSDL2_KeycodeToImGuiKey(event->key.keysym.sym), (event->type == SDL_KEYDOWN),
+                event->key.keysym.sym, event->key.keysym.scancode);
+            break;
+        }
+        case SDL_WINDOWEVENT:
+        {
+            // LEAVE is delayed by a frame on the Dear ImGui thread, see ImGui_ImplSDL2_ProcessEvent()
+            Uint8 window_event = event->window.event;
+            if (window_event == SDL_WINDOWEVENT_ENTER)
+                inputs->Events.push_back(ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_MouseEnter));
+            if (window_event == SDL_WINDOWEVENT_LEAVE)
+                inputs->Events.push_back(ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_MouseLeave));
+            if (window_event == SDL_WINDOWEVENT_FOCUS_GAINED || window_event == SDL_WINDOWEVENT_FOCUS_LOST)
+            {
+                ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_Focus);
+                input.Down = (window_event == SDL_WINDOWEVENT_FOCUS_GAINED);
+                inputs->Events.push_back(input);
+            }
+            break;
+        }
+        case SDL_CLIPBOARDUPDATE:
+        {
+            bd->ClipboardFetched = false;
+            break;
+        }
+    }
+}
+
+// The SDL thread half of ImGui_ImplSDL2_NewFrame()
+void ImGui_ImplSDL2_RecordFrame(ImGui_ImplSDL2_Outputs* outputs, ImGui_ImplSDL2_Inputs* inputs)
+{
+    ImGui_ImplSDL2_Data* bd = g_ThreadedBackendData;
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplSDL2_SetThreaded(true)?");
+
+    // Setup display size (every frame to accommodate for window resizing)
+    int w, h;
+    int display_w, display_h;
+    SDL_GetWindowSize(bd->Window, &w, &h);
+    if (SDL_GetWindowFlags(bd->Window) & SDL_WINDOW_MINIMIZED)
+        w = h = 0;
+    if (bd->Renderer != nullptr)
+        SDL_GetRendererOutputSize(bd->Renderer, &display_w, &display_h);
+    else
+        SDL_GL_GetDrawableSize(bd->Window, &display_w, &display_h);
+    inputs->DisplaySize = ImVec2((float)w, (float)h);
+    if (w > 0 && h > 0)
+        inputs->DisplayFramebufferScale = ImVec2((float)display_w / w, (float)display_h / h);
+
+    // Mouse capture, warp and focused position, as in ImGui_ImplSDL2_UpdateMouseData()
+#if SDL_HAS_CAPTURE_AND_GLOBAL_MOUSE
+    SDL_CaptureMouse((bd->MouseButtonsDown != 0 && !outputs->DragDropActive) ? SDL_TRUE : SDL_FALSE);
+    SDL_Window* focused_window = SDL_GetKeyboardFocus();
+    const bool is_app_focused = (bd->Window == focused_window);
+#else
+    const bool is_app_focused = (SDL_GetWindowFlags(bd->Window) & SDL_WINDOW_INPUT_FOCUS) != 0; // SDL 2.0.3 and non-windowed systems: single-viewport only
+#endif
+    if (is_app_focused)
+    {
+        if (outputs->WantSetMousePos)
+            SDL_WarpMouseInWindow(bd->Window, (int)outputs->MousePos.x, (int)outputs->MousePos.y);
+        if (bd->MouseCanUseGlobalState && bd->MouseButtonsDown == 0)
+        {
+            int window_x, window_y, mouse_x_global, mouse_y_global;
+            SDL_GetGlobalMouseState(&mouse_x_global, &mouse_y_global);
+            SDL_GetWindowPosition(bd->Window, &window_x, &window_y);
+            ImGui_ImplSDL2_RecordMousePos(inputs, (float)(mouse_x_global - window_x), (float)(mouse_y_global - window_y));
+        }
+    }
+    outputs->WantSetMousePos = false;
+
+    // Mouse cursor, as in ImGui_ImplSDL2_UpdateMouseCursor() but only when it changed as this may run more often than frames
+    if (outputs->MouseCursor != ImGuiMouseCursor_COUNT && outputs->MouseCursor != bd->AppliedMouseCursor)
+    {
+        if (outputs->MouseCursor == ImGuiMouseCursor_None)
+        {
+            SDL_ShowCursor(SDL_FALSE);
+        }
+        else
+        {
+            SDL_SetCursor(bd->MouseCursors[outputs->MouseCursor] ? bd->MouseCursors[outputs->MouseCursor] : bd->MouseCursors[ImGuiMouseCursor_Arrow]);
+            SDL_ShowCursor(SDL_TRUE);
+        }
+        bd->AppliedMouseCursor = outputs->MouseCursor;
+    }
+
+    // Clipboard
+    if (outputs->SetClipboard)
+    {
+        SDL_SetClipboardText(outputs->ClipboardText.Data);
+        outputs->SetClipboard = false;
+    }
+    if (!bd->ClipboardFetched)
+    {
+        char* text = SDL_GetClipboardText();
+        ImGui_ImplSDL2_CopyText(inputs->ClipboardText, text ? text : "");
+        SDL_free(text);
+        inputs->ClipboardChanged = true;
+        bd->ClipboardFetched = true;
+    }
+
+    // Update game controllers (if enabled and available)
+    const auto add_key = [](void* user_data, ImGuiKey key, bool down, float value)
+    {
+        ImGui_ImplSDL2_Input input = ImGui_ImplSDL2_MakeInput(ImGui_ImplSDL2_InputType_KeyAnalog);
+        input.Key = key;
+        input.Down = down;
+        input.X = value;
+        ((ImGui_ImplSDL2_Inputs*)user_data)->Events.push_back(input);
+    };
+    inputs->HasGamepad = outputs->PollGamepads && ImGui_ImplSDL2_ReadGamepad(add_key, inputs);
+}
+
+// The Dear ImGui thread half of ImGui_ImplSDL2_NewFrame(), also applies the recorded events
+void ImGui_ImplSDL2_NewFrameFromInputs(ImGui_ImplSDL2_Inputs* inputs)
+{
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplSDL2_Init()?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    io.DisplaySize = inputs->DisplaySize;
+    if (inputs->DisplaySize.x > 0.0f && inputs->DisplaySize.y > 0.0f)
+        io.DisplayFramebufferScale = inputs->DisplayFramebufferScale;
+
+    // Setup time step (we don't use SDL_GetTicks() because it is using millisecond resolution)
+    static Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 current_time = SDL_GetPerformanceCounter();
+    io.DeltaTime = bd->Time > 0 ? (float)((double)(current_time - bd->Time) / frequency) : (float)(1.0f / 60.0f);
+    bd->Time = current_time;
+
+    if (inputs->ClipboardChanged)
+    {
+        bd->InputClipboardText.swap(inputs->ClipboardText);
+        inputs->ClipboardChanged = false;
+    }
+
+    for (const ImGui_ImplSDL2_Input& input : inputs->Events)
+    {
+        switch (input.Type)
+        {
+            case ImGui_ImplSDL2_InputType_MousePos:
+                io.AddMousePosEvent(input.X, input.Y);
+                break;
+            case ImGui_ImplSDL2_InputType_MouseWheel:
+                io.AddMouseWheelEvent(input.X, input.Y);
+                break;
+            case ImGui_ImplSDL2_InputType_MouseButton:
+                io.AddMouseButtonEvent(input.Key, input.Down);
+                bd->InputMouseButtonsDown = input.Down ? (bd->InputMouseButtonsDown | (1 << input.Key)) : (bd->InputMouseButtonsDown & ~(1 << input.Key));
+                break;
+            case ImGui_ImplSDL2_InputType_MouseEnter:
+                bd->PendingMouseLeaveFrame = 0;
+                break;
+            case ImGui_ImplSDL2_InputType_MouseLeave:
+                bd->PendingMouseLeaveFrame = ImGui::GetFrameCount() + 1;
+                break;
+            case ImGui_ImplSDL2_InputType_Text:
+                io.AddInputCharactersUTF8(input.Text);
+                break;
+            case ImGui_ImplSDL2_InputType_Key:
+                io.AddKeyEvent((ImGuiKey)input.Key, input.Down);
+                if (input.NativeKeycode != -1)
+                    io.SetKeyEventNativeData((ImGuiKey)input.Key, input.NativeKeycode, input.NativeScancode, input.NativeScancode); // To support legacy indexing (<1.87 user code)
+                break;
+            case ImGui_ImplSDL2_InputType_KeyAnalog:
+                io.AddKeyAnalogEvent((ImGuiKey)input.Key, input.Down, input.X);
+                break;
+            case ImGui_ImplSDL2_InputType_Focus:
+                io.AddFocusEvent(input.Down);
+                break;
+        }
+    }
+    inputs->Events.resize(0);
+
+    if (inputs->HasGamepad)
+        io.BackendFlags |= ImGuiBackendFlags_HasGamepad;
+    else
+        io.BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
+
+    if (bd->PendingMouseLeaveFrame && bd->PendingMouseLeaveFrame >= ImGui::GetFrameCount() && bd->InputMouseButtonsDown == 0)
+    {
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+        bd->PendingMouseLeaveFrame = 0;
+    }
+}
+
+// What the SDL thread needs from the frame that just ended, one shot requests are kept until applied
+void ImGui_ImplSDL2_RecordOutputs(ImGui_ImplSDL2_Outputs* outputs)
+{
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplSDL2_Init()?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange)
+    {
+        outputs->MouseCursor = ImGuiMouseCursor_COUNT;
+    }
+    else
+    {
+        // Hide OS mouse cursor if imgui is drawing it or if it wants no cursor
+        ImGuiMouseCursor imgui_cursor = ImGui::GetMouseCursor();
+        outputs->MouseCursor = (io.MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None) ? ImGuiMouseCursor_None : imgui_cursor;
+    }
+    outputs->DragDropActive = ImGui::GetDragDropPayload() != nullptr;
+    outputs->PollGamepads = (io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) != 0;
+    if (io.WantSetMousePos)
+    {
+        outputs->WantSetMousePos = true;
+        outputs->MousePos = io.MousePos;
+    }
+    if (bd->HasPendingClipboardText)
+    {
+        outputs->ClipboardText.swap(bd->PendingClipboardText);
+        outputs->SetClipboard = true;
+        bd->HasPendingClipboardText = false;
+    }
+}
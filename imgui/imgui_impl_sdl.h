@@ -31,6 +31,51 @@ IMGUI_IMPL_API void     ImGui_ImplSDL2_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplSDL2_NewFrame();
 IMGUI_IMPL_API bool     ImGui_ImplSDL2_ProcessEvent(const SDL_Event* event);
 
+// (Optional) Threaded use, for running the Dear ImGui frame on another thread than the one that initialized SDL video (SDL only
+// supports its window, event, mouse, cursor and clipboard functions on that thread, on macOS anything else breaks):
+// - Init/Shutdown and SetThreaded() run on the SDL thread while the other thread isn't using the context.
+// - The SDL thread records every event with RecordEvent() and the per-frame platform state (display size, focused mouse position,
+//   gamepads) with RecordFrame(), which also applies the outputs of the last Dear ImGui frame (cursor, mouse capture and warp, clipboard).
+// - The Dear ImGui thread calls NewFrameFromInputs() instead of NewFrame(), which replays the recorded inputs and empties them,
+//   and RecordOutputs() once the frame has ended. ProcessEvent() and NewFrame() aren't used.
+// The functions touch no Dear ImGui state on the SDL thread, guarding the inputs and outputs with a mutex is up to the application.
+struct ImGui_ImplSDL2_Input
+{
+    int             Type;                   // ImGui_ImplSDL2_InputType_ (see imgui_impl_sdl.cpp)
+    int             Key;                    // ImGuiKey, mouse button index or focus
+    int             NativeKeycode;          // SDL_Keycode, -1 for modifiers
+    int             NativeScancode;
+    bool            Down;
+    float           X, Y;                   // mouse position, wheel or analog value (X)
+    char            Text[32];               // text input, utf-8
+};
+struct ImGui_ImplSDL2_Inputs
+{
+    ImVector<ImGui_ImplSDL2_Input> Events;  // in order, must not be dropped
+    ImVec2          DisplaySize;            // latest
+    ImVec2          DisplayFramebufferScale;
+    bool            HasGamepad;
+    bool            ClipboardChanged;       // ClipboardText has been refreshed
+    ImVector<char>  ClipboardText;          // null terminated
+    ImGui_ImplSDL2_Inputs() { HasGamepad = ClipboardChanged = false; }
+};
+struct ImGui_ImplSDL2_Outputs
+{
+    int             MouseCursor;            // ImGuiMouseCursor, ImGuiMouseCursor_None hides it, ImGuiMouseCursor_COUNT leaves it alone
+    bool            DragDropActive;         // no mouse capture while drag and dropping
+    bool            PollGamepads;           // ImGuiConfigFlags_NavEnableGamepad
+    bool            WantSetMousePos;        // one shot, cleared once applied
+    ImVec2          MousePos;
+    bool            SetClipboard;           // one shot, cleared once applied
+    ImVector<char>  ClipboardText;
+    ImGui_ImplSDL2_Outputs() { MouseCursor = ImGuiMouseCursor_COUNT; DragDropActive = PollGamepads = WantSetMousePos = SetClipboard = false; }
+};
+IMGUI_IMPL_API void     ImGui_ImplSDL2_SetThreaded(bool threaded);
+IMGUI_IMPL_API void     ImGui_ImplSDL2_RecordEvent(const SDL_Event* event, ImGui_ImplSDL2_Inputs* inputs);
+IMGUI_IMPL_API void     ImGui_ImplSDL2_RecordFrame(ImGui_ImplSDL2_Outputs* outputs, ImGui_ImplSDL2_Inputs* inputs);
+IMGUI_IMPL_API void     ImGui_ImplSDL2_NewFrameFromInputs(ImGui_ImplSDL2_Inputs* inputs);
+IMGUI_IMPL_API void     ImGui_ImplSDL2_RecordOutputs(ImGui_ImplSDL2_Outputs* outputs);
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline void ImGui_ImplSDL2_NewFrame(SDL_Window*) { ImGui_ImplSDL2_NewFrame(); } // 1.84: removed unnecessary parameter
 #endif
@@ -0,0 +1,97 @@
+#include "instanced-quads.hpp"
+
+#include "gl-state.hpp"
+#include "shader.hpp"
+
+#include <glad/gl.h>
+
+#include <cstddef>
+
+static_assert(
+  sizeof(quad_instance_t) == sizeof(float) * 20,
+  "quad_instance_t must match the instance attribute layout");
+
+const char* const g_instanced_vertex_shader_source =
+  R"(#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in mat4 aModel;
+layout (location = 5) in vec4 aColor;
+layout (std140, binding = 2) uniform camera
+{
+  mat4 view_projection;
+};
+out vec4 Color;
+void main()
+{
+  gl_Position = view_projection * aModel * vec4(aPos, 1.0);
+  Color = aColor;
+})";
+
+const char* const g_instanced_fragment_shader_source =
+  R"(#version 460 core
+out vec4 FragColor;
+in vec4 Color;
+void main()
+{
+  FragColor = Color;
+})";
+
+instanced_quads_t create_instanced_quads(const uint32_t vao)
+{
+  instanced_quads_t instanced_quads;
+  instanced_quads.program = create_shader(
+    g_instanced_vertex_shader_source, g_instanced_fragment_shader_source);
+
+  glGenBuffers(1, &instanced_quads.instance_vbo);
+
+  gl_state_bind_vertex_array(vao);
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, instanced_quads.instance_vbo);
+
+  // a mat4 attribute occupies four consecutive locations (one per column)
+  for (uint32_t column = 0; column < 4; ++column) {
+    const uint32_t location = 1 + column;
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(
+      location, 4, GL_FLOAT, GL_FALSE, sizeof(quad_instance_t),
+      (void*)(offsetof(quad_instance_t, model) + column * 4 * sizeof(float)));
+    glVertexAttribDivisor(location, 1);
+  }
+
+  glEnableVertexAttribArray(5);
+  glVertexAttribPointer(
+    5, 4, GL_FLOAT, GL_FALSE, sizeof(quad_instance_t),
+    (void*)offsetof(quad_instance_t, color));
+  glVertexAttribDivisor(5, 1);
+
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, 0);
+  gl_state_bind_vertex_array(0);
+
+  return instanced_quads;
+}
+
+void destroy_instanced_quads(instanced_quads_t& instanced_quads)
+{
+  gl_state_delete_buffers(1, &instanced_quads.instance_vbo);
+  destroy_shader(instanced_quads.program);
+  instanced_quads = instanced_quads_t{};
+}
+
+void upload_instanced_quads(
+  instanced_quads_t& instanced_quads, const std::vector<quad_instance_t>& quads)
+{
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, instanced_quads.instance_vbo);
+  glBufferData(
+    GL_ARRAY_BUFFER, quads.size() * sizeof(quad_instance_t), quads.data(),
+    GL_STATIC_DRAW);
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, 0);
+  instanced_quads.instance_count = static_cast<int32_t>(quads.size());
+}
+
+void draw_instanced_quads(
+  const instanced_quads_t& instanced_quads, const uint32_t vao)
+{
+  gl_state_use_program(instanced_quads.program.id);
+  gl_state_bind_vertex_array(vao);
+  glDrawElementsInstanced(
+    GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, instanced_quads.instance_count);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <as/as-math-ops.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// per-quad data stored in the instance buffer
+struct quad_instance_t
+{
+  as::mat4 model;
+  as::vec4 color;
+};
+
+// draws every quad sharing the quad vao with a single instanced draw call,
+// the view projection is read from the camera uniform block (binding 2)
+struct instanced_quads_t
+{
+  shader_program_t program;
+  uint32_t instance_vbo = 0;
+  int32_t instance_count = 0;
+};
+
+// adds the per-instance attributes (locations 1-5) to the existing quad vao
+instanced_quads_t create_instanced_quads(uint32_t vao);
+void destroy_instanced_quads(instanced_quads_t& instanced_quads);
+
+// only required when the quads change, not every frame
+void upload_instanced_quads(
+  instanced_quads_t& instanced_quads,
+  const std::vector<quad_instance_t>& quads);
+
+void draw_instanced_quads(
+  const instanced_quads_t& instanced_quads, uint32_t vao);
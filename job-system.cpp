@@ -0,0 +1,201 @@
+#include "job-system.hpp"
+
+#include "cpu-profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a range of a parallel_for
+struct job_t
+{
+  const std::function<void(int64_t, int64_t)>* fn = nullptr;
+  int64_t begin = 0;
+  int64_t end = 0;
+  std::atomic<int64_t>* remaining = nullptr; // jobs of the parallel_for
+};
+
+// the owner takes jobs from the front and thieves from the back so they work
+// from opposite ends of the contiguous block a parallel_for hands each deque,
+// jobs are large enough that a lock per deque doesn't contend
+struct alignas(64) job_deque_t
+{
+  std::mutex mutex;
+  std::deque<job_t> jobs;
+};
+
+struct job_scheduler_t
+{
+  std::vector<std::unique_ptr<job_deque_t>> deques; // one per worker
+  std::vector<std::thread> workers;
+  std::atomic<int64_t> queued = 0; // jobs in any deque
+  // idle workers sleep until jobs are pushed or the system is destroyed
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  bool stop = false;
+};
+
+static bool pop_job(job_scheduler_t& scheduler, const int32_t index, job_t& job)
+{
+  job_deque_t& deque = *scheduler.deques[index];
+  const std::lock_guard<std::mutex> lock(deque.mutex);
+  if (deque.jobs.empty()) {
+    return false;
+  }
+  job = deque.jobs.front();
+  deque.jobs.pop_front();
+  scheduler.queued.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+// tries every other deque starting after index (-1 starts at the first)
+static bool steal_job(
+  job_scheduler_t& scheduler, const int32_t index, job_t& job)
+{
+  const auto deque_count = static_cast<int32_t>(scheduler.deques.size());
+  for (int32_t i = 1; i <= deque_count; ++i) {
+    const int32_t victim = (index + i) % deque_count;
+    if (victim == index) {
+      continue;
+    }
+    job_deque_t& deque = *scheduler.deques[victim];
+    const std::lock_guard<std::mutex> lock(deque.mutex);
+    if (!deque.jobs.empty()) {
+      job = deque.jobs.back();
+      deque.jobs.pop_back();
+      scheduler.queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void run_job(const job_t& job)
+{
+  (*job.fn)(job.begin, job.end);
+  // publishes the job's writes to the thread waiting in parallel_for
+  job.remaining->fetch_sub(1, std::memory_order_release);
+}
+
+static void worker_main(job_scheduler_t& scheduler, const int32_t index)
+{
+  set_cpu_profiler_thread_name("job worker");
+  for (;;) {
+    job_t job;
+    if (pop_job(scheduler, index, job) || steal_job(scheduler, index, job)) {
+      const cpu_zone_t zone("job");
+      run_job(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(scheduler.sleep_mutex);
+    scheduler.wake.wait(lock, [&scheduler] {
+      return scheduler.stop
+          || scheduler.queued.load(std::memory_order_relaxed) > 0;
+    });
+    if (scheduler.stop) {
+      return;
+    }
+  }
+}
+
+job_system_t create_job_system(const int32_t worker_count)
+{
+  job_system_t job_system;
+  if (worker_count <= 0) {
+    return job_system;
+  }
+  job_system.scheduler = new job_scheduler_t;
+  job_system.worker_count = worker_count;
+  for (int32_t i = 0; i < worker_count; ++i) {
+    job_system.scheduler->deques.push_back(std::make_unique<job_deque_t>());
+  }
+  for (int32_t i = 0; i < worker_count; ++i) {
+    job_system.scheduler->workers.emplace_back(
+      worker_main, std::ref(*job_system.scheduler), i);
+  }
+  return job_system;
+}
+
+void destroy_job_system(job_system_t& job_system)
+{
+  if (job_system.scheduler != nullptr) {
+    {
+      const std::lock_guard<std::mutex> lock(
+        job_system.scheduler->sleep_mutex);
+      job_system.scheduler->stop = true;
+    }
+    job_system.scheduler->wake.notify_all();
+    for (std::thread& worker : job_system.scheduler->workers) {
+      worker.join();
+    }
+    delete job_system.scheduler;
+  }
+  job_system = job_system_t{};
+}
+
+int32_t default_job_worker_count()
+{
+  const auto hardware_threads =
+    static_cast<int32_t>(std::thread::hardware_concurrency());
+  return std::max(hardware_threads - 1, 0);
+}
+
+int32_t job_system_thread_count(const job_system_t& job_system)
+{
+  return job_system.worker_count + 1;
+}
+
+void parallel_for(
+  job_system_t& job_system, const int64_t count, const int64_t grain_size,
+  const std::function<void(int64_t begin, int64_t end)>& fn)
+{
+  if (count <= 0) {
+    return;
+  }
+
+  // a few jobs per thread so stealing can even out uneven ranges
+  const int64_t job_count = std::min(
+    (count + std::max(grain_size, int64_t(1)) - 1)
+      / std::max(grain_size, int64_t(1)),
+    int64_t(job_system_thread_count(job_system)) * 4);
+  if (job_system.scheduler == nullptr || job_count <= 1) {
+    fn(0, count);
+    return;
+  }
+
+  job_scheduler_t& scheduler = *job_system.scheduler;
+  std::atomic<int64_t> remaining = job_count;
+  const auto deque_count = static_cast<int64_t>(scheduler.deques.size());
+  for (int64_t d = 0; d < deque_count; ++d) {
+    // a contiguous block of jobs per deque
+    const int64_t first_job = job_count * d / deque_count;
+    const int64_t last_job = job_count * (d + 1) / deque_count;
+    job_deque_t& deque = *scheduler.deques[d];
+    const std::lock_guard<std::mutex> lock(deque.mutex);
+    for (int64_t j = first_job; j < last_job; ++j) {
+      deque.jobs.push_back(job_t{
+        &fn, count * j / job_count, count * (j + 1) / job_count, &remaining});
+    }
+  }
+  scheduler.queued.fetch_add(job_count, std::memory_order_relaxed);
+  {
+    // a worker can't be between checking for jobs and sleeping meanwhile
+    const std::lock_guard<std::mutex> lock(scheduler.sleep_mutex);
+  }
+  scheduler.wake.notify_all();
+
+  // help until every job has run (possibly jobs of other parallel_fors)
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    job_t job;
+    if (steal_job(scheduler, -1, job)) {
+      run_job(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
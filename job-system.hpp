@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+struct job_scheduler_t;
+
+// a pool of worker threads with a deque of jobs each, a worker that runs out
+// steals from the others and the thread waiting on parallel_for runs jobs
+// too, without workers everything runs inline on the calling thread in order
+// (deterministic, for debugging)
+struct job_system_t
+{
+  job_scheduler_t* scheduler = nullptr; // null when single threaded
+  int32_t worker_count = 0;
+};
+
+// worker_count 0 is the single threaded mode
+job_system_t create_job_system(int32_t worker_count);
+void destroy_job_system(job_system_t& job_system);
+
+// one less than the hardware threads, the caller of parallel_for is the last
+int32_t default_job_worker_count();
+
+// workers plus the calling thread
+int32_t job_system_thread_count(const job_system_t& job_system);
+
+// calls fn with disjoint ranges covering [0, count), each at least
+// grain_size long (except when count is smaller), and returns once all of
+// them have run, fn is called concurrently from several threads
+void parallel_for(
+  job_system_t& job_system, int64_t count, int64_t grain_size,
+  const std::function<void(int64_t begin, int64_t end)>& fn);
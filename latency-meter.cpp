@@ -0,0 +1,94 @@
+#include "latency-meter.hpp"
+
+#include "cpu-profiler.hpp"
+
+#include <glad/gl.h>
+
+latency_meter_t create_latency_meter(const int32_t latency)
+{
+  latency_meter_t latency_meter;
+  latency_meter.queries.resize(latency);
+  latency_meter.input_times.resize(latency);
+  latency_meter.clock_offsets.resize(latency);
+  glGenQueries(latency, latency_meter.queries.data());
+  return latency_meter;
+}
+
+void destroy_latency_meter(latency_meter_t& latency_meter)
+{
+  glDeleteQueries(
+    static_cast<int32_t>(latency_meter.queries.size()),
+    latency_meter.queries.data());
+  latency_meter = latency_meter_t{};
+}
+
+static int32_t slot_count(const latency_meter_t& latency_meter)
+{
+  return static_cast<int32_t>(latency_meter.queries.size());
+}
+
+// reads back the oldest pending slot, returns false if wait is false and the
+// result isn't available yet
+static bool resolve_oldest(latency_meter_t& latency_meter, const bool wait)
+{
+  const int32_t count = slot_count(latency_meter);
+  const int32_t oldest =
+    (latency_meter.slot - latency_meter.pending + count) % count;
+  const uint32_t query = latency_meter.queries[oldest];
+  if (!wait) {
+    uint32_t available = GL_FALSE;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+      return false;
+    }
+  }
+  uint64_t gpu_time = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &gpu_time);
+  const int64_t completion_time =
+    static_cast<int64_t>(gpu_time) + latency_meter.clock_offsets[oldest];
+  latency_meter.latency =
+    static_cast<float>(completion_time - latency_meter.input_times[oldest])
+    * 1e-9f;
+  latency_meter.total_latency += latency_meter.latency;
+  latency_meter.sample_count++;
+  latency_meter.pending--;
+  return true;
+}
+
+void end_latency_meter_frame(
+  latency_meter_t& latency_meter, const int64_t input_time)
+{
+  if (input_time >= 0) {
+    if (latency_meter.pending == slot_count(latency_meter)) {
+      resolve_oldest(latency_meter, true);
+    }
+    // the current gpu time is when the gpu reached the commands issued so
+    // far (without waiting for them), close enough to pair with the cpu
+    // time taken right after it
+    int64_t gpu_now = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    const int64_t cpu_now = static_cast<int64_t>(cpu_profiler_now());
+    glQueryCounter(latency_meter.queries[latency_meter.slot], GL_TIMESTAMP);
+    latency_meter.input_times[latency_meter.slot] = input_time;
+    latency_meter.clock_offsets[latency_meter.slot] = cpu_now - gpu_now;
+    latency_meter.slot = (latency_meter.slot + 1) % slot_count(latency_meter);
+    latency_meter.pending++;
+  }
+  while (latency_meter.pending > 0 && resolve_oldest(latency_meter, false)) {
+  }
+}
+
+void reset_latency_meter(latency_meter_t& latency_meter)
+{
+  latency_meter.latency = 0.0f;
+  latency_meter.total_latency = 0.0;
+  latency_meter.sample_count = 0;
+}
+
+float latency_meter_mean(const latency_meter_t& latency_meter)
+{
+  return latency_meter.sample_count > 0
+         ? static_cast<float>(
+             latency_meter.total_latency / latency_meter.sample_count)
+         : 0.0f;
+}
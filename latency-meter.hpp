@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// time from an input event to the gpu finishing the frame that used it, a
+// timestamp query marks the end of each frame and is mapped onto the cpu
+// clock with the offset between the two clocks sampled when it was issued,
+// results are read back a few frames late like gpu_timer_t
+struct latency_meter_t
+{
+  std::vector<uint32_t> queries; // a timestamp query per slot
+  std::vector<int64_t> input_times; // ns (cpu_profiler_now), per slot
+  std::vector<int64_t> clock_offsets; // cpu minus gpu ns, per slot
+  int32_t slot = 0; // next slot to write
+  int32_t pending = 0; // slots written but not yet read back
+  float latency = 0.0f; // seconds, most recent result
+  double total_latency = 0.0; // seconds, sum of every result
+  int64_t sample_count = 0;
+};
+
+latency_meter_t create_latency_meter(int32_t latency = 4);
+void destroy_latency_meter(latency_meter_t& latency_meter);
+
+// call after the last command of the frame, input_time is when the newest
+// input the frame used happened (cpu_profiler_now clock), frames without new
+// input pass a negative time and aren't measured
+void end_latency_meter_frame(
+  latency_meter_t& latency_meter, int64_t input_time);
+
+// drops the results so far (pending frames are still measured)
+void reset_latency_meter(latency_meter_t& latency_meter);
+
+// mean over every result so far in seconds
+float latency_meter_mean(const latency_meter_t& latency_meter);
@@ -8,26 +8,79 @@
 #include "imgui/imgui_impl_opengl3.h"
 #include "imgui/imgui_impl_sdl.h"
 
+#include "cpu-culling.hpp"
+#include "cpu-profiler.hpp"
+#include "draw-commands.hpp"
+#include "frame-bench.hpp"
+#include "frame-pacing.hpp"
+#include "frustum.hpp"
+#include "gl-state.hpp"
+#include "gpu-culling.hpp"
+#include "gpu-profiler.hpp"
+#include "gpu-timer.hpp"
+#include "hiz.hpp"
+#include "instanced-quads.hpp"
+#include "job-system.hpp"
+#include "latency-meter.hpp"
+#include "scene-store.hpp"
+#include "scene-targets.hpp"
+#include "shader.hpp"
+#include "streaming-buffer.hpp"
+#include "texture-pool.hpp"
+#include "triple-buffer.hpp"
+#include "ui-cache.hpp"
+#include "z-fighting.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
 #include <chrono>
+#include <cmath>
+#include <cstdarg>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
-
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// per-draw data is read from a block of draws (see draw_uniforms_t) indexed
+// by the base instance of the draw call, the view projection from the camera
+// block shared by every scene shader (see camera_uniforms_t)
 const char* const g_vertex_shader_source =
-  R"(#version 330 core
+  R"(#version 460 core
 layout (location = 0) in vec3 aPos;
-uniform mat4 mvp;
+struct draw_t
+{
+  mat4 model;
+  vec4 color;
+};
+layout (std140, binding = 1) uniform draws
+{
+  draw_t draw[128];
+};
+layout (std140, binding = 2) uniform camera
+{
+  mat4 view_projection;
+};
+flat out vec4 Color;
 void main()
 {
-  gl_Position = mvp * vec4(aPos, 1.0);
+  gl_Position =
+    view_projection * draw[gl_BaseInstance].model * vec4(aPos, 1.0);
+  Color = draw[gl_BaseInstance].color;
 })";
 
 const char* const g_fragment_shader_source =
-  R"(#version 330 core
+  R"(#version 460 core
 out vec4 FragColor;
-uniform vec4 color;
+flat in vec4 Color;
 void main()
 {
-  FragColor = color;
+  FragColor = Color;
 })";
 
 const char* const g_screen_vertex_shader_source =
@@ -43,6 +96,18 @@ void main()
   TexCoords = aTexCoords;
 })";
 
+// attributeless, one triangle covering the screen from gl_VertexID (0-2)
+const char* const g_fullscreen_triangle_vertex_shader_source =
+  R"(#version 330 core
+out vec2 TexCoords;
+
+void main()
+{
+  vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+  gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+  TexCoords = position;
+})";
+
 const char* const g_screen_fragment_shader_source =
   R"(#version 330 core
 out vec4 FragColor;
@@ -50,21 +115,42 @@ out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
+uniform vec2 uv_scale; // fraction of the texture the scene was rendered to
+
+// kept half a texel inside the rendered area so filtering never reads
+// outside of it
+vec2 scaled_uv(vec2 uv)
+{
+  return min(
+    uv * uv_scale, uv_scale - 0.5 / vec2(textureSize(screenTexture, 0)));
+}
 
 void main()
 {
-  FragColor = texture(screenTexture, TexCoords);
+  FragColor = texture(screenTexture, scaled_uv(TexCoords));
 })";
 
 const char* const g_screen_depth_fragment_shader_source =
-  R"(#version 330 core
+  R"(#version 460 core
 out vec4 FragColor;
 
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
-uniform float near;
-uniform float far;
+uniform vec2 uv_scale; // fraction of the texture the scene was rendered to
+layout (std140, binding = 0) uniform frame
+{
+  float near;
+  float far;
+};
+
+// kept half a texel inside the rendered area so filtering never reads
+// outside of it
+vec2 scaled_uv(vec2 uv)
+{
+  return min(
+    uv * uv_scale, uv_scale - 0.5 / vec2(textureSize(screenTexture, 0)));
+}
 
 // return depth value in range near to far
 float linearize_depth(in vec2 uv)
@@ -76,7 +162,7 @@ float linearize_depth(in vec2 uv)
 
 void main()
 {
-  float c = linearize_depth(TexCoords);
+  float c = linearize_depth(scaled_uv(TexCoords));
   vec3 range = vec3(c - near)/(far - near); // convert to [0,1]
   FragColor = vec4(range, 1.0);
 })";
@@ -89,6 +175,14 @@ enum class render_mode_e
   depth
 };
 
+// how the offscreen scene reaches the window
+enum class present_mode_e
+{
+  quad, // two triangles from the screen quad vertex buffer
+  triangle, // a single attributeless triangle
+  blit // glBlitFramebuffer, color render mode only
+};
+
 enum class depth_mode_e
 {
   normal,
@@ -98,12 +192,143 @@ enum class depth_mode_e
 enum class layout_mode_e
 {
   near,
-  fighting
+  fighting,
+  stress
+};
+
+enum class quad_mode_e
+{
+  individual,
+  instanced,
+  indirect,
+  gpu_culled
+};
+
+const int g_stress_quad_counts[] = {1'000, 100'000, 1'000'000};
+
+// matches the std140 layout of the draws uniform block in the main shader
+struct draw_uniforms_t
+{
+  as::mat4 model;
+  as::vec4 color;
+};
+
+static_assert(sizeof(draw_uniforms_t) == sizeof(float) * 20);
+
+// matches the std140 layout of the camera uniform block read by the scene
+// shaders, written each time the scene is rendered and again when late latched
+struct camera_uniforms_t
+{
+  as::mat4 view_projection;
+};
+
+static_assert(sizeof(camera_uniforms_t) == sizeof(float) * 16);
+
+// matches the std140 layout of the frame uniform block in the depth shader
+struct frame_uniforms_t
+{
+  float near;
+  float far;
+};
+
+const int g_draws_per_block = 128; // size of the draws array in the shader
+
+// how long the drawable size has to stay the same before the offscreen
+// targets follow it, avoids reallocating every frame of a drag resize
+const float g_resize_debounce = 0.15f; // seconds
+
+// F9 writes the cpu zones of the last few seconds as a chrome trace
+const double g_cpu_trace_seconds = 5.0;
+const char* const g_cpu_trace_path = "cpu-trace.json";
+
+// resolutions the color format benchmark renders at (1080p and 4k)
+const int32_t g_color_format_benchmark_sizes[][2] = {
+  {1920, 1080}, {3840, 2160}};
+
+// mean gpu time of each pass for one color format at one resolution
+struct color_format_benchmark_t
+{
+  color_format_e color_format;
+  int32_t width;
+  int32_t height;
+  float scene_time; // seconds
+  float present_time;
+};
+
+// opengl-sdl-bench is this renderer built without a display, it runs the
+// frame benchmark on a hidden window and exits
+#ifdef HEADLESS_BENCH
+constexpr bool g_headless = true;
+#else
+constexpr bool g_headless = false;
+#endif
+
+// the frame benchmark runs every layout, depth and render mode in turn,
+// warm up frames let the layout, targets and gpu timers settle after a change
+const int g_frame_bench_warm_up_frame_count = 30;
+const int32_t g_frame_bench_size[2] = {1280, 720};
+const char* const g_frame_bench_layout_mode_names[] = {
+  "near", "fighting", "stress"};
+const char* const g_frame_bench_depth_mode_names[] = {"normal", "reverse"};
+const char* const g_frame_bench_render_mode_names[] = {"color", "depth"};
+const int g_frame_bench_combination_count =
+  std::size(g_frame_bench_layout_mode_names)
+  * std::size(g_frame_bench_depth_mode_names)
+  * std::size(g_frame_bench_render_mode_names);
+
+// the main thread handles events and steps the camera at a fixed rate, the
+// render thread owns the gl context and draws with the newest camera, sdl's
+// window, event, mouse and clipboard functions are only made on the main
+// thread (the one that initialized video, other threads break on macos)
+const float g_simulation_rate = 240.0f; // hz
+
+// what the main thread hands the render thread every simulation tick
+struct simulation_state_t
+{
+  asc::Camera camera;
+  int drawable_width = 0;
+  int drawable_height = 0;
+  // last time the window reported a new size
+  std::chrono::steady_clock::time_point resize_time;
+  int64_t trace_request_count = 0; // f9 presses so far
+  int64_t input_time = -1; // newest mouse motion (cpu_profiler_now ns)
+  float tick_time = 0.0f; // seconds handling events and stepping
+  // seconds, longest between event polls over the previous second
+  float poll_gap_max = 0.0f;
+};
+
+// pixels of the current layout where the depth test picks the wrong quad
+struct z_fighting_result_t
+{
+  depth_format_e depth_format;
+  depth_mode_e depth_mode;
+  int32_t pixel_count;
 };
 
 depth_mode_e g_depth_mode = depth_mode_e::normal;
 render_mode_e g_render_mode = render_mode_e::color;
+present_mode_e g_present_mode = present_mode_e::quad;
 layout_mode_e g_layout_mode = layout_mode_e::near;
+pacing_mode_e g_pacing_mode = pacing_mode_e::vsync;
+quad_mode_e g_quad_mode = quad_mode_e::individual;
+color_format_e g_color_format = color_format_e::rgba32f;
+depth_format_e g_depth_format = depth_format_e::d32fs8;
+bool g_cpu_culling = false; // applies to individual and indirect quad modes
+bool g_occlusion_culling = false; // applies to gpu culled quad mode
+bool g_imgui_persistent_buffers = false;
+bool g_imgui_persistent_vertex_arrays = true;
+bool g_imgui_alpha8_fonts = false; // --alpha8-fonts, single channel atlas
+bool g_retained_ui = false;
+// renders the scene to a fraction of the targets sized to fit the budget
+bool g_dynamic_resolution = false;
+float g_gpu_budget = 14.0f; // ms for the scene and present passes
+// takes the newest camera again after the scene draws are recorded and
+// updates the camera they read before they're flushed
+bool g_late_latch = false;
+bool g_measure_latency = false; // input to gpu completion of the frame
+// runs every job inline on the calling thread, for deterministic debugging
+bool g_single_threaded_jobs = false; // --single-threaded-jobs
+int g_stress_quad_count_index = 0;
 
 namespace asc
 {
@@ -115,66 +340,252 @@ Handedness handedness()
 
 } // namespace asc
 
-uint32_t create_shader(
-  const char* vertex_shader_source, const char* fragment_shader_source)
-{
-  constexpr int info_log_size = 512;
-  char info_log[info_log_size];
-  info_log[0] = '\0';
-
-  uint32_t vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-  glCompileShader(vertex_shader);
-  int vertex_shader_success;
-  glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &vertex_shader_success);
-  if (!vertex_shader_success) {
-    glGetShaderInfoLog(vertex_shader, info_log_size, NULL, info_log);
-    std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
-              << info_log << '\0';
+// lets the imgui backend go through the gl state shadow as well
+ImGui_ImplOpenGL3_StateCache imgui_gl_state_cache()
+{
+  ImGui_ImplOpenGL3_StateCache state_cache = {};
+  state_cache.GetIntegerv = gl_state_get_integerv;
+  state_cache.IsEnabled = [](const uint32_t cap) -> unsigned char {
+    return gl_state_is_enabled(cap) ? GL_TRUE : GL_FALSE;
+  };
+  state_cache.Enable = gl_state_enable;
+  state_cache.Disable = gl_state_disable;
+  state_cache.UseProgram = gl_state_use_program;
+  state_cache.ActiveTexture = gl_state_active_texture;
+  state_cache.BindTexture = gl_state_bind_texture;
+  state_cache.BindSampler = gl_state_bind_sampler;
+  state_cache.BindVertexArray = gl_state_bind_vertex_array;
+  state_cache.BindBuffer = gl_state_bind_buffer;
+  state_cache.BlendEquation = gl_state_blend_equation;
+  state_cache.BlendEquationSeparate = gl_state_blend_equation_separate;
+  state_cache.BlendFuncSeparate = gl_state_blend_func_separate;
+  state_cache.Viewport = gl_state_viewport;
+  state_cache.Scissor = gl_state_scissor;
+  state_cache.PolygonMode = gl_state_polygon_mode;
+  state_cache.DeleteTextures = gl_state_delete_textures;
+  state_cache.DeleteBuffers = gl_state_delete_buffers;
+  state_cache.DeleteVertexArrays = gl_state_delete_vertex_arrays;
+  state_cache.DeleteProgram = gl_state_delete_program;
+  return state_cache;
+}
+
+// stats lines keyed by their format string, when throttled the text is only
+// reformatted a few times a second so values that change every frame don't
+// invalidate the retained ui
+struct stats_text_t
+{
+  std::vector<std::pair<const char*, std::string>> lines;
+  float age = 0.0f; // seconds since the last refresh
+  bool refresh = true;
+};
+
+void begin_stats_text(
+  stats_text_t& stats, const bool throttle, const float delta_time)
+{
+  constexpr float refresh_interval = 0.5f;
+  stats.age += delta_time;
+  stats.refresh = !throttle || stats.age >= refresh_interval;
+  if (stats.refresh) {
+    stats.age = 0.0f;
   }
+}
 
-  uint32_t fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-  glCompileShader(fragment_shader);
-  int fragment_shader_success;
-  glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &fragment_shader_success);
-  if (!fragment_shader_success) {
-    glGetShaderInfoLog(fragment_shader, info_log_size, NULL, info_log);
-    std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n"
-              << info_log << '\0';
+void stats_text(stats_text_t& stats, const char* format, ...)
+{
+  auto line = std::find_if(
+    stats.lines.begin(), stats.lines.end(),
+    [format](const auto& entry) { return entry.first == format; });
+  if (line == stats.lines.end()) {
+    line = stats.lines.insert(line, {format, std::string()});
+  } else if (!stats.refresh) {
+    ImGui::TextUnformatted(line->second.c_str());
+    return;
   }
+  char text[256];
+  va_list args;
+  va_start(args, format);
+  std::vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  line->second = text;
+  ImGui::TextUnformatted(line->second.c_str());
+}
 
-  uint32_t shader_program = glCreateProgram();
-  glAttachShader(shader_program, vertex_shader);
-  glAttachShader(shader_program, fragment_shader);
-  glLinkProgram(shader_program);
-  int shader_program_success;
-  glGetProgramiv(shader_program, GL_LINK_STATUS, &shader_program_success);
-  if (!shader_program_success) {
-    glGetProgramInfoLog(shader_program, info_log_size, NULL, info_log);
-    std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << info_log << '\0';
+void print_color_format_benchmarks(
+  const std::vector<color_format_benchmark_t>& benchmarks)
+{
+  printf(
+    "%-12s %-10s %10s %10s %12s\n", "format", "size", "target MB", "scene ms",
+    "present ms");
+  for (const color_format_benchmark_t& benchmark : benchmarks) {
+    const float target_size =
+      float(benchmark.width) * float(benchmark.height)
+      * float(color_format_bytes_per_pixel(benchmark.color_format))
+      / (1024.0f * 1024.0f);
+    printf(
+      "%-12s %4dx%-5d %10.1f %10.3f %12.3f\n",
+      color_format_name(benchmark.color_format), benchmark.width,
+      benchmark.height, target_size, benchmark.scene_time * 1000.0f,
+      benchmark.present_time * 1000.0f);
   }
+}
 
-  glDeleteShader(vertex_shader);
-  glDeleteShader(fragment_shader);
+// gpu time scales roughly with the number of pixels shaded so the scale
+// (applied to both axes) moves by the square root of the budget ratio, damped
+// so a noisy sample or the timer latency doesn't make it oscillate
+float update_render_scale(
+  const float render_scale, const float gpu_time, const float gpu_budget)
+{
+  constexpr float min_render_scale = 0.25f;
+  constexpr float max_render_scale = 1.0f;
+  constexpr float damping = 0.2f; // of the correction applied per sample
+  constexpr float dead_band = 0.05f; // close enough to the budget
+  if (
+    gpu_time <= 0.0f
+    || std::abs(gpu_time - gpu_budget) < gpu_budget * dead_band) {
+    return render_scale;
+  }
+  const float target_scale = render_scale * std::sqrt(gpu_budget / gpu_time);
+  return std::clamp(
+    render_scale + (target_scale - render_scale) * damping, min_render_scale,
+    max_render_scale);
+}
 
-  return shader_program;
+// a blit copies color as is, depth still has to go through the shader
+present_mode_e resolve_present_mode(
+  const present_mode_e present_mode, const render_mode_e render_mode)
+{
+  if (
+    present_mode == present_mode_e::blit
+    && render_mode != render_mode_e::color) {
+    return present_mode_e::triangle;
+  }
+  return present_mode;
 }
 
-void draw_quad(
-  const as::mat4& view_projection, const as::mat4& model, const as::vec4& color,
-  const uint32_t mvp_loc, const uint32_t color_loc, const uint32_t vao)
+// draw_index selects the draw in the currently bound draws uniform block
+void draw_quad(const uint32_t draw_index, const uint32_t vao)
 {
-  const as::mat4 model_view_projection = as::mat_mul(model, view_projection);
-  glUniformMatrix4fv(
-    mvp_loc, 1, GL_FALSE, as::mat_const_data(model_view_projection));
-  glUniform4fv(color_loc, 1, as::vec_const_data(color));
-  glBindVertexArray(vao);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  gl_state_bind_vertex_array(vao);
+  glDrawElementsInstancedBaseInstance(
+    GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, 1, draw_index);
+}
+
+// a quad of one of the fixed layouts
+struct layout_quad_t
+{
+  as::vec3 position;
+  as::vec3 scale;
+  as::vec4 color;
+};
+
+// overlapping quads far away, close enough in depth to z-fight
+const layout_quad_t g_fighting_layout[] = {
+  {as::vec3(-10.0f, 25.0f, -500.02f), as::vec3(100.0f, 100.0f, 1.0f),
+   as::vec4(1.0f, 0.5f, 0.2f, 1.0f)},
+  {as::vec3(10.0f, -25.0f, -499.98f), as::vec3(100.0f, 100.0f, 1.0f),
+   as::vec4(1.0f, 0.0f, 0.0f, 1.0f)},
+  {as::vec3(-10.0f, 0.0f, -500.0f), as::vec3(100.0f, 100.0f, 1.0f),
+   as::vec4(0.1f, 0.2f, 0.6f, 1.0f)},
+  {as::vec3(10.0f, 0.0f, -500.01f), as::vec3(100.0f, 100.0f, 1.0f),
+   as::vec4(0.1f, 0.8f, 0.2f, 1.0f)}};
+
+// quads spread between the near and far planes
+const layout_quad_t g_near_layout[] = {
+  {as::vec3(-0.25f, 0.25f, -1.0f), as::vec3(1.0f, 1.0f, 1.0f),
+   as::vec4(1.0f, 0.5f, 0.2f, 1.0f)},
+  {as::vec3(0.25f, -0.25f, -3.0f), as::vec3(1.0f, 1.0f, 1.0f),
+   as::vec4(1.0f, 0.0f, 0.0f, 1.0f)},
+  {as::vec3(-0.25f, 5.5f, -20.0f), as::vec3(1.0f, 1.0f, 1.0f),
+   as::vec4(0.1f, 0.2f, 0.6f, 1.0f)},
+  {as::vec3(-30.0f, 0.0f, -80.0f), as::vec3(1.0f, 1.0f, 1.0f),
+   as::vec4(0.1f, 0.8f, 0.2f, 1.0f)}};
+
+// fill a cube of quads in front of the camera
+void add_stress_layout(
+  job_system_t& job_system, scene_store_t& scene, const int quad_count)
+{
+  int side = 1;
+  while (side * side * side < quad_count) {
+    side++;
+  }
+
+  const float spacing = 2.0f;
+  const float offset = float(side - 1) * spacing * 0.5f;
+
+  const size_t first = add_scene_entities(scene, quad_count);
+  parallel_for(
+    job_system, quad_count, 4096, [&](const int64_t begin, const int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        const int x = int(i % side);
+        const int y = int((i / side) % side);
+        const int z = int(i / (side * side));
+        scene.position[first + i] = as::vec3(
+          float(x) * spacing - offset, float(y) * spacing - offset,
+          -10.0f - float(z) * spacing);
+        scene.color[first + i] = as::vec4(
+          float(x) / float(side), float(y) / float(side),
+          float(z) / float(side), 1.0f);
+      }
+    });
+}
+
+// replaces the entities of the scene with the layout
+void fill_scene_layout(
+  job_system_t& job_system, scene_store_t& scene,
+  const layout_mode_e layout_mode, const int stress_quad_count)
+{
+  clear_scene(scene);
+  const auto add_layout = [&scene](const auto& layout) {
+    for (const layout_quad_t& quad : layout) {
+      add_scene_entity(scene, quad.position, quad.scale, quad.color);
+    }
+  };
+  switch (layout_mode) {
+    case layout_mode_e::fighting:
+      add_layout(g_fighting_layout);
+      break;
+    case layout_mode_e::near:
+      add_layout(g_near_layout);
+      break;
+    case layout_mode_e::stress:
+      add_stress_layout(job_system, scene, stress_quad_count);
+      break;
+  }
 }
 
 int main(int argc, char** argv)
 {
+  // runs the color format benchmark on the first frame, prints it and exits
+  bool color_format_benchmark_only = false;
+  // runs the frame benchmark with vsync off, writes the results and exits
+  bool frame_bench_only = g_headless;
+  int frame_bench_frame_count = 300; // timed frames per combination
+  // csv unless the extension is .json
+  std::string_view frame_bench_path = "frame-bench.csv";
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view(argv[i]) == "--alpha8-fonts") {
+      g_imgui_alpha8_fonts = true;
+    } else if (std::string_view(argv[i]) == "--color-format-benchmark") {
+      color_format_benchmark_only = true;
+    } else if (std::string_view(argv[i]) == "--frame-bench") {
+      frame_bench_only = true;
+    } else if (std::string_view(argv[i]) == "--frames" && i + 1 < argc) {
+      frame_bench_frame_count = std::max(std::atoi(argv[++i]), 1);
+    } else if (std::string_view(argv[i]) == "--output" && i + 1 < argc) {
+      frame_bench_path = argv[++i];
+    } else if (std::string_view(argv[i]) == "--single-threaded-jobs") {
+      g_single_threaded_jobs = true;
+    }
+  }
+
+  if (g_headless) {
+    // no display needed, the environment can still pick another driver
+    SDL_SetHintWithPriority(
+      SDL_HINT_VIDEODRIVER, "offscreen", SDL_HINT_DEFAULT);
+    // lets mesa's egl (llvmpipe included) run without a window system
+    SDL_setenv("EGL_PLATFORM", "surfaceless", 0);
+  }
+
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
     return 1;
@@ -185,12 +596,13 @@ int main(int argc, char** argv)
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 6);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
 
-  const int width = 1024;
-  const int height = 768;
-  const float aspect = float(width) / float(height);
   SDL_Window* window = SDL_CreateWindow(
-    argv[0], SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height,
-    SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL);
+    argv[0], SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+    frame_bench_only ? g_frame_bench_size[0] : 1024,
+    frame_bench_only ? g_frame_bench_size[1] : 768,
+    g_headless ? SDL_WINDOW_HIDDEN | SDL_WINDOW_OPENGL
+               : SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE
+                   | SDL_WINDOW_ALLOW_HIGHDPI);
 
   if (window == nullptr) {
     printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
@@ -199,7 +611,11 @@ int main(int argc, char** argv)
 
   const SDL_GLContext context = SDL_GL_CreateContext(window);
   SDL_GL_MakeCurrent(window, context);
-  SDL_GL_SetSwapInterval(1); // enable vsync
+  // the frame benchmark times the frames themselves, not the display
+  if (frame_bench_only) {
+    g_pacing_mode = pacing_mode_e::uncapped;
+  }
+  frame_pacer_t frame_pacer = create_frame_pacer(g_pacing_mode);
 
   const int version = gladLoadGL((GLADloadfunc)SDL_GL_GetProcAddress);
   if (version == 0) {
@@ -214,12 +630,36 @@ int main(int argc, char** argv)
   // ensure OpenGL uses 0 to 1 for NDC instead of -1 to 1
   glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
 
-  const uint32_t main_shader_program =
+  // all per-frame state changes go through the shadow from here on
+  sync_gl_state();
+
+  set_cpu_profiler_thread_name("main");
+
+  // in pixels, differs from the window size on high dpi displays
+  int width = 0;
+  int height = 0;
+  SDL_GL_GetDrawableSize(window, &width, &height);
+
+  shader_program_t main_shader_program =
     create_shader(g_vertex_shader_source, g_fragment_shader_source);
-  const uint32_t screen_shader_program = create_shader(
+  shader_program_t screen_shader_program = create_shader(
     g_screen_vertex_shader_source, g_screen_fragment_shader_source);
-  const uint32_t depth_screen_shader_program = create_shader(
+  shader_program_t depth_screen_shader_program = create_shader(
     g_screen_vertex_shader_source, g_screen_depth_fragment_shader_source);
+  shader_program_t triangle_screen_shader_program = create_shader(
+    g_fullscreen_triangle_vertex_shader_source,
+    g_screen_fragment_shader_source);
+  shader_program_t triangle_depth_screen_shader_program = create_shader(
+    g_fullscreen_triangle_vertex_shader_source,
+    g_screen_depth_fragment_shader_source);
+  const int32_t screen_uv_scale_loc =
+    shader_uniform_location(screen_shader_program, "uv_scale");
+  const int32_t depth_screen_uv_scale_loc =
+    shader_uniform_location(depth_screen_shader_program, "uv_scale");
+  const int32_t triangle_screen_uv_scale_loc =
+    shader_uniform_location(triangle_screen_shader_program, "uv_scale");
+  const int32_t triangle_depth_screen_uv_scale_loc =
+    shader_uniform_location(triangle_depth_screen_shader_program, "uv_scale");
 
   float vertices[] = {
     0.5f,  0.5f,  0.0f, // top right
@@ -246,8 +686,8 @@ int main(int argc, char** argv)
   glGenVertexArrays(1, &quad_vao);
   glGenBuffers(1, &quad_vbo);
 
-  glBindVertexArray(quad_vao);
-  glBindBuffer(GL_ARRAY_BUFFER, quad_vbo);
+  gl_state_bind_vertex_array(quad_vao);
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, quad_vbo);
   glBufferData(
     GL_ARRAY_BUFFER, sizeof(screen_vertices), screen_vertices, GL_STATIC_DRAW);
   glEnableVertexAttribArray(0);
@@ -256,17 +696,21 @@ int main(int argc, char** argv)
   glVertexAttribPointer(
     1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, 0);
+  gl_state_bind_vertex_array(0);
+
+  // core profile draws need a vao even without attributes
+  uint32_t empty_vao;
+  glGenVertexArrays(1, &empty_vao);
 
   uint32_t vbo, vao, ebo;
   glGenVertexArrays(1, &vao);
   glGenBuffers(1, &vbo);
   glGenBuffers(1, &ebo);
 
-  glBindVertexArray(vao);
+  gl_state_bind_vertex_array(vao);
 
-  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, vbo);
   glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
@@ -276,39 +720,51 @@ int main(int argc, char** argv)
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
   glEnableVertexAttribArray(0);
 
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
-
-  uint32_t texture_colorbuffer;
-  glGenTextures(1, &texture_colorbuffer);
-  glBindTexture(GL_TEXTURE_2D, texture_colorbuffer);
-  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA32F, width, height);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  uint32_t texture_depth_stencil_buffer;
-  glGenTextures(1, &texture_depth_stencil_buffer);
-  glBindTexture(GL_TEXTURE_2D, texture_depth_stencil_buffer);
-  glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH32F_STENCIL8, width, height);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  uint32_t framebuffer;
-  glGenFramebuffers(1, &framebuffer);
-  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-  glFramebufferTexture2D(
-    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_colorbuffer,
-    0);
-  glFramebufferTexture2D(
-    GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D,
-    texture_depth_stencil_buffer, 0);
-
-  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-    std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!\n";
-  }
-
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-  glViewport(0, 0, width, height);
-
+  gl_state_bind_buffer(GL_ARRAY_BUFFER, 0);
+  gl_state_bind_vertex_array(0);
+
+  // offscreen targets are reallocated through the pool (resizes, format
+  // changes and benchmarks)
+  texture_pool_t texture_pool;
+  scene_targets_t scene_targets = create_scene_targets(
+    texture_pool, width, height, g_color_format, g_depth_format);
+  int resize_count = 0;
+  // fraction of the targets rendered to (per axis) with dynamic resolution
+  float render_scale = 1.0f;
+  int64_t render_scale_sample_count = 0; // scene timer samples used so far
+
+  hiz_t hiz = create_hiz(width, height);
+
+  // per-frame and per-draw uniforms, grows if a frame needs more space
+  streaming_buffer_t streaming_buffer =
+    create_streaming_buffer(1024 * 1024, 3);
+
+  gpu_profiler_t gpu_profiler = create_gpu_profiler();
+  const int32_t scene_pass = add_gpu_profiler_pass(gpu_profiler, "scene");
+  const int32_t hiz_pass = add_gpu_profiler_pass(gpu_profiler, "hiz");
+  // one per present mode so each can be compared
+  const int32_t present_passes[] = {
+    add_gpu_profiler_pass(gpu_profiler, "present_quad"),
+    add_gpu_profiler_pass(gpu_profiler, "present_triangle"),
+    add_gpu_profiler_pass(gpu_profiler, "present_blit")};
+  const int32_t ui_pass = add_gpu_profiler_pass(gpu_profiler, "ui");
+  const gpu_timer_t& scene_timer = gpu_profiler.passes[scene_pass].timer;
+  const char* gpu_profile_path = "gpu-profile.csv";
+  bool gpu_profile_written = false;
+  std::vector<color_format_benchmark_t> color_format_benchmarks;
+  bool run_color_format_benchmark = color_format_benchmark_only;
+  z_fighting_t z_fighting = create_z_fighting(width, height);
+  std::vector<z_fighting_result_t> z_fighting_results;
+  bool measure_z_fighting = false;
+  std::vector<frame_bench_result_t> frame_bench_results;
+  int frame_bench_combination = 0;
+  int frame_bench_frame = 0; // of the current combination, warm up included
+  std::vector<float> frame_bench_cpu_times; // ms
+  std::vector<float> frame_bench_gpu_times;
+  int exit_code = 0;
+  latency_meter_t latency_meter = create_latency_meter();
+
+  // stepped on the main thread
   asc::Camera camera;
   camera.pivot = as::vec3(0.0f, 0.0f, 4.0f);
   asc::Camera target_camera = camera;
@@ -320,211 +776,1122 @@ int main(int argc, char** argv)
   camera_system.cameras_.addCamera(&translate_camera);
   camera_system.cameras_.addCamera(&rotate_camera);
 
+  // the render thread takes the newest state each frame (and again when late
+  // latching), the initial state is published so there always is one
+  triple_buffer_t<simulation_state_t> simulation_states;
+  triple_buffer_back(simulation_states).camera = camera;
+  triple_buffer_back(simulation_states).drawable_width = width;
+  triple_buffer_back(simulation_states).drawable_height = height;
+  publish_triple_buffer(simulation_states);
+  // imgui's platform side runs on the main thread, its inputs are recorded
+  // there and replayed by the render thread, which sends back what the frame
+  // wants of the platform (cursor, mouse capture, clipboard), unlike the
+  // simulation state every input has to arrive so they're queued
+  std::mutex imgui_platform_mutex;
+  ImGui_ImplSDL2_Inputs imgui_inputs;
+  ImGui_ImplSDL2_Outputs imgui_outputs;
+  std::atomic<bool> quit = false; // set by either thread
+
   float near = 5.0f;
   float far = 100.0f;
 
   ImGui::CreateContext();
 
   ImGui_ImplSDL2_InitForOpenGL(window, context);
+  ImGui_ImplSDL2_SetThreaded(true);
   ImGui_ImplOpenGL3_Init();
+  // vaos are per context, lets the backend keep one for each
+  ImGui_ImplOpenGL3_SetCurrentContextFn(SDL_GL_GetCurrentContext);
+  g_imgui_persistent_vertex_arrays =
+    ImGui_ImplOpenGL3_SetUsePersistentVertexArrays(true);
+  const ImGui_ImplOpenGL3_StateCache imgui_state_cache =
+    imgui_gl_state_cache();
+  ImGui_ImplOpenGL3_SetStateCache(&imgui_state_cache);
+  ui_cache_t ui_cache = create_ui_cache();
+  stats_text_t ui_stats;
+  // before the first frame so startup creates the atlas in this format
+  g_imgui_alpha8_fonts =
+    ImGui_ImplOpenGL3_SetUseAlpha8FontsTexture(g_imgui_alpha8_fonts)
+    && g_imgui_alpha8_fonts;
+
+  job_system_t job_system = create_job_system(
+    g_single_threaded_jobs ? 0 : default_job_worker_count());
+  scene_store_t scene;
+  fill_scene_layout(
+    job_system, scene, g_layout_mode,
+    g_stress_quad_counts[g_stress_quad_count_index]);
+  // the visible entities of the scene in its dense order, what the renderer
+  // and culling iterate
+  std::vector<quad_instance_t> quads;
+  quads_from_scene(job_system, scene, quads);
+  instanced_quads_t instanced_quads = create_instanced_quads(vao);
+  upload_instanced_quads(instanced_quads, quads);
+  draw_commands_t draw_commands = create_draw_commands();
+  gpu_culling_t gpu_culling = create_gpu_culling();
+  upload_gpu_culling_bounds(gpu_culling, quads);
+  cull_bounds_t cull_bounds = cull_bounds_from_quads(job_system, quads);
+  std::vector<uint32_t> visible_quads;
 
   layout_mode_e prev_layout_mode = g_layout_mode;
-  auto prev = std::chrono::system_clock::now();
-  for (bool quit = false; !quit;) {
-    for (SDL_Event current_event; SDL_PollEvent(&current_event) != 0;) {
-      ImGui_ImplSDL2_ProcessEvent(&current_event);
-      if (current_event.type == SDL_QUIT) {
-        quit = true;
-        break;
+  int prev_stress_quad_count_index = g_stress_quad_count_index;
+  // name lookups made during the previous frame (should stay at zero)
+  int string_lookups = 0;
+  // gl state changes and queries made during the previous frame
+  gl_state_stats_t frame_gl_state_stats;
+  // render thread copy of the simulation state
+  simulation_state_t simulation;
+  int64_t latched_input_time = -1; // newest input measured so far
+  int64_t handled_trace_request_count = 0; // f9 presses
+  float swap_time = 0.0f; // seconds, last frame
+  // everything gl happens on the render thread from here on
+  const auto render_loop = [&] {
+    set_cpu_profiler_thread_name("render");
+    SDL_GL_MakeCurrent(window, context);
+    while (!quit) {
+      const cpu_zone_t frame_zone("frame");
+      const auto frame_begin = std::chrono::steady_clock::now();
+      const uint64_t string_lookup_count = shader_string_lookup_count();
+      const gl_state_stats_t gl_state_stats_begin = gl_state_stats();
+
+      // newest mouse motion this frame's camera has seen that hasn't been
+      // measured yet, negative if there's none
+      int64_t input_time = -1;
+      const auto latch_simulation = [&] {
+        acquire_triple_buffer(simulation_states);
+        simulation = triple_buffer_front(simulation_states);
+        if (simulation.input_time > latched_input_time) {
+          input_time = simulation.input_time;
+          latched_input_time = input_time;
+        }
+      };
+      latch_simulation();
+
+      if (simulation.trace_request_count != handled_trace_request_count) {
+        handled_trace_request_count = simulation.trace_request_count;
+        const bool written =
+          write_cpu_trace(g_cpu_trace_path, g_cpu_trace_seconds);
+        printf(
+          "%s %s\n", written ? "wrote" : "failed to write", g_cpu_trace_path);
       }
-      camera_system.handleEvents(asci_sdl::sdlToInput(&current_event));
-    }
 
-    auto now = std::chrono::system_clock::now();
-    auto delta = now - prev;
-    prev = now;
+      if (frame_bench_only) {
+        const int render_mode_count =
+          std::size(g_frame_bench_render_mode_names);
+        const int depth_mode_count = std::size(g_frame_bench_depth_mode_names);
+        g_render_mode = static_cast<render_mode_e>(
+          frame_bench_combination % render_mode_count);
+        g_depth_mode = static_cast<depth_mode_e>(
+          frame_bench_combination / render_mode_count % depth_mode_count);
+        g_layout_mode = static_cast<layout_mode_e>(
+          frame_bench_combination / (render_mode_count * depth_mode_count));
+      }
 
-    const float delta_time =
-      std::chrono::duration_cast<fp_seconds>(delta).count();
+      const float delta_time = begin_frame_pacer_frame(frame_pacer);
+
+      // until the targets catch up they are stretched over the window, the
+      // projection already uses the new aspect so the scene isn't distorted
+      width = simulation.drawable_width;
+      height = simulation.drawable_height;
+      if (
+        width > 0 && height > 0
+        && (width != scene_targets.width || height != scene_targets.height)
+        && std::chrono::duration_cast<fp_seconds>(
+             std::chrono::steady_clock::now() - simulation.resize_time)
+               .count()
+             >= g_resize_debounce) {
+        destroy_scene_targets(texture_pool, scene_targets);
+        scene_targets = create_scene_targets(
+          texture_pool, width, height, g_color_format, g_depth_format);
+        resize_hiz(hiz, width, height);
+        resize_z_fighting(z_fighting, width, height);
+        resize_count++;
+      }
 
-    target_camera = camera_system.stepCamera(target_camera, delta_time);
-    camera = asci::smoothCamera(
-      camera, target_camera, asci::SmoothProps{}, delta_time);
+      const as::mat4 perspective_projection =
+        as::normalize_unit_range(as::perspective_opengl_rh(
+          as::radians(60.0f), float(width) / float(std::max(height, 1)), near,
+          far));
+      const as::mat4 reverse_z_perspective_projection =
+        as::reverse_z(perspective_projection);
+
+      if (
+        g_layout_mode != prev_layout_mode
+        || g_stress_quad_count_index != prev_stress_quad_count_index) {
+        fill_scene_layout(
+          job_system, scene, g_layout_mode,
+          g_stress_quad_counts[g_stress_quad_count_index]);
+        quads_from_scene(job_system, scene, quads);
+        upload_instanced_quads(instanced_quads, quads);
+        upload_gpu_culling_bounds(gpu_culling, quads);
+        cull_bounds = cull_bounds_from_quads(job_system, quads);
+        hiz.valid = false;
+        prev_stress_quad_count_index = g_stress_quad_count_index;
+      }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+      if (g_layout_mode != prev_layout_mode) {
+        if (g_layout_mode == layout_mode_e::fighting) {
+          near = 0.01f;
+          far = 10000.0f;
+        } else if (g_layout_mode == layout_mode_e::near) {
+          near = 5.0f;
+          far = 100.0f;
+        } else if (g_layout_mode == layout_mode_e::stress) {
+          near = 1.0f;
+          far = 500.0f;
+        }
+        prev_layout_mode = g_layout_mode;
+      }
 
-    glEnable(GL_DEPTH_TEST);
-    if (g_depth_mode == depth_mode_e::reverse) {
-      glClearDepth(0.0f);
-      glDepthFunc(GL_GREATER);
-    } else if (g_depth_mode == depth_mode_e::normal) {
-      glClearDepth(1.0f);
-      glDepthFunc(GL_LESS);
-    }
+      const auto compute_view_projection = [&] {
+        const as::mat4 view = as::mat4_from_affine(simulation.camera.view());
+        if (g_depth_mode == depth_mode_e::normal) {
+          return as::mat_mul(view, perspective_projection);
+        }
+        if (g_depth_mode == depth_mode_e::reverse) {
+          return as::mat_mul(view, reverse_z_perspective_projection);
+        }
+        return as::mat4::identity();
+      };
+      // replaced by the late latched camera right before the scene draws
+      as::mat4 view_projection = compute_view_projection();
+
+      float cpu_cull_time = 0.0f;
+      if (g_cpu_culling) {
+        const cpu_zone_t zone("cpu cull");
+        const auto cull_begin = std::chrono::steady_clock::now();
+        cull_spheres_parallel(
+          job_system, cull_bounds,
+          frustum_planes_from_view_projection(view_projection), visible_quads);
+        cpu_cull_time = std::chrono::duration_cast<fp_seconds>(
+                          std::chrono::steady_clock::now() - cull_begin)
+                          .count();
+      }
 
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      const size_t individual_draw_count =
+        g_quad_mode != quad_mode_e::individual ? 0
+        : g_cpu_culling                        ? visible_quads.size()
+                                               : quads.size();
+      const int64_t draw_block_size =
+        sizeof(draw_uniforms_t) * g_draws_per_block;
+      const int64_t draw_block_count =
+        (individual_draw_count + g_draws_per_block - 1) / g_draws_per_block;
+      // blocks are allocated together and bound at aligned offsets
+      const int64_t draw_block_stride =
+        (draw_block_size + streaming_buffer.alignment - 1)
+        / streaming_buffer.alignment * streaming_buffer.alignment;
+
+      // everything a frame allocates from the streaming buffer
+      const int64_t frame_streaming_size =
+        draw_block_count * draw_block_stride + sizeof(frame_uniforms_t)
+        + sizeof(camera_uniforms_t) + streaming_buffer.alignment * 3;
+
+      // draws the quads into targets with the current modes, occlusion_hiz is
+      // only used by the gpu culled quad mode, late_latch takes the newest
+      // camera once everything but the draws is done
+      const auto render_scene = [&](
+                                  const scene_targets_t& targets,
+                                  const hiz_t* occlusion_hiz,
+                                  const bool late_latch) {
+        glBindFramebuffer(GL_FRAMEBUFFER, targets.framebuffer);
+        gl_state_viewport(0, 0, targets.render_width, targets.render_height);
+
+        // written right before the draws are issued (see below)
+        const streaming_allocation_t camera_allocation =
+          allocate_streaming_buffer(
+            streaming_buffer, sizeof(camera_uniforms_t));
+        glBindBufferRange(
+          GL_UNIFORM_BUFFER, 2, streaming_buffer.buffer,
+          camera_allocation.offset, sizeof(camera_uniforms_t));
+
+        gl_state_enable(GL_DEPTH_TEST);
+        if (g_depth_mode == depth_mode_e::reverse) {
+          glClearDepth(0.0f);
+          gl_state_depth_func(GL_GREATER);
+        } else if (g_depth_mode == depth_mode_e::normal) {
+          glClearDepth(1.0f);
+          gl_state_depth_func(GL_LESS);
+        }
+
+        // only what's rendered to needs clearing
+        const bool partial = targets.render_width != targets.width
+                          || targets.render_height != targets.height;
+        if (partial) {
+          gl_state_scissor(0, 0, targets.render_width, targets.render_height);
+          gl_state_enable(GL_SCISSOR_TEST);
+        }
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        if (partial) {
+          gl_state_disable(GL_SCISSOR_TEST);
+        }
+
+        gl_state_use_program(main_shader_program.id);
+
+        // write the per-draw data of individual quads straight into the
+        // mapped buffer on the job system, the draws bind a block at a time
+        // and pick their entry with their base instance
+        streaming_allocation_t allocation;
+        if (g_quad_mode == quad_mode_e::individual) {
+          const cpu_zone_t zone("fill draw blocks");
+          allocation = allocate_streaming_buffer(
+            streaming_buffer, draw_block_count * draw_block_stride);
+          parallel_for(
+            job_system, draw_block_count, 1,
+            [&](const int64_t begin, const int64_t end) {
+              for (int64_t block = begin; block < end; ++block) {
+                auto* draws = reinterpret_cast<draw_uniforms_t*>(
+                  static_cast<uint8_t*>(allocation.data)
+                  + block * draw_block_stride);
+                const size_t first = block * g_draws_per_block;
+                const size_t last = std::min(
+                  first + g_draws_per_block, individual_draw_count);
+                for (size_t i = first; i < last; ++i) {
+                  const quad_instance_t& quad =
+                    quads[g_cpu_culling ? visible_quads[i] : i];
+                  draws[i - first] = draw_uniforms_t{quad.model, quad.color};
+                }
+              }
+            });
+        } else if (g_quad_mode == quad_mode_e::indirect) {
+          clear_draw_commands(draw_commands);
+          if (g_cpu_culling) {
+            for (const uint32_t index : visible_quads) {
+              record_draw_command(draw_commands, 6, 0, 0, index);
+            }
+          } else {
+            for (uint32_t i = 0; i < quads.size(); ++i) {
+              record_draw_command(draw_commands, 6, 0, 0, i);
+            }
+          }
+        }
+
+        // the mapping is coherent, a cpu write is only guaranteed to be seen
+        // by commands issued after it, so the camera goes in before the first
+        // draw and every draw of the frame (and gpu culling) reads the same
+        // one, cpu culling has used the earlier camera
+        if (late_latch) {
+          const cpu_zone_t zone("late latch");
+          latch_simulation();
+          view_projection = compute_view_projection();
+        }
+        *static_cast<camera_uniforms_t*>(camera_allocation.data) =
+          camera_uniforms_t{view_projection};
+
+        switch (g_quad_mode) {
+          case quad_mode_e::individual: {
+            for (int64_t block = 0; block < draw_block_count; ++block) {
+              glBindBufferRange(
+                GL_UNIFORM_BUFFER, 1, streaming_buffer.buffer,
+                allocation.offset + block * draw_block_stride,
+                draw_block_size);
+              const size_t block_draw_count = std::min(
+                individual_draw_count - block * g_draws_per_block,
+                size_t(g_draws_per_block));
+              for (size_t i = 0; i < block_draw_count; ++i) {
+                draw_quad(static_cast<uint32_t>(i), vao);
+              }
+            }
+          } break;
+          case quad_mode_e::instanced:
+            draw_instanced_quads(instanced_quads, vao);
+            break;
+          case quad_mode_e::indirect:
+            submit_draw_commands(
+              draw_commands, vao, instanced_quads.instance_vbo);
+            break;
+          case quad_mode_e::gpu_culled:
+            cull_and_draw_quads(
+              gpu_culling, view_projection, vao, instanced_quads.instance_vbo,
+              occlusion_hiz);
+            break;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      };
+
+      // draws the color (or linearized depth) of the rendered area of targets
+      // over the whole of framebuffer (0 for the window), upscaled bilinearly
+      const auto present_scene = [&](
+                                   const scene_targets_t& targets,
+                                   const uint32_t framebuffer,
+                                   const int32_t framebuffer_width,
+                                   const int32_t framebuffer_height) {
+        const present_mode_e present_mode =
+          resolve_present_mode(g_present_mode, g_render_mode);
+        if (present_mode == present_mode_e::blit) {
+          // covers the whole framebuffer so there's nothing to clear
+          gl_state_disable(GL_SCISSOR_TEST);
+          glBindFramebuffer(GL_READ_FRAMEBUFFER, targets.framebuffer);
+          glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+          const bool scaled = targets.render_width != framebuffer_width
+                           || targets.render_height != framebuffer_height;
+          glBlitFramebuffer(
+            0, 0, targets.render_width, targets.render_height, 0, 0,
+            framebuffer_width, framebuffer_height, GL_COLOR_BUFFER_BIT,
+            scaled ? GL_LINEAR : GL_NEAREST);
+          glBindFramebuffer(GL_FRAMEBUFFER, 0);
+          return;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        gl_state_viewport(0, 0, framebuffer_width, framebuffer_height);
+        gl_state_disable(GL_DEPTH_TEST);
+
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        const bool triangle = present_mode == present_mode_e::triangle;
+        const float uv_scale[] = {
+          float(targets.render_width) / float(targets.width),
+          float(targets.render_height) / float(targets.height)};
+        if (g_render_mode == render_mode_e::color) {
+          gl_state_use_program(
+            triangle ? triangle_screen_shader_program.id
+                     : screen_shader_program.id);
+          glUniform2fv(
+            triangle ? triangle_screen_uv_scale_loc : screen_uv_scale_loc, 1,
+            uv_scale);
+        } else {
+          gl_state_use_program(
+            triangle ? triangle_depth_screen_shader_program.id
+                     : depth_screen_shader_program.id);
+          glUniform2fv(
+            triangle ? triangle_depth_screen_uv_scale_loc
+                     : depth_screen_uv_scale_loc,
+            1, uv_scale);
+          const streaming_allocation_t allocation = allocate_streaming_buffer(
+            streaming_buffer, sizeof(frame_uniforms_t));
+          *static_cast<frame_uniforms_t*>(allocation.data) =
+            frame_uniforms_t{near, far};
+          glBindBufferRange(
+            GL_UNIFORM_BUFFER, 0, streaming_buffer.buffer, allocation.offset,
+            sizeof(frame_uniforms_t));
+        }
+
+        gl_state_bind_vertex_array(triangle ? empty_vao : quad_vao);
+
+        if (g_render_mode == render_mode_e::color) {
+          gl_state_bind_texture(GL_TEXTURE_2D, targets.color_texture);
+        } else {
+          gl_state_bind_texture(GL_TEXTURE_2D, targets.depth_texture);
+        }
+
+        glDrawArrays(GL_TRIANGLES, 0, triangle ? 3 : 6);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      };
+
+      // every color format at 1080p and 4k presenting to an rgba8 target of
+      // the same size, timed frames run back to back without swapping
+      if (run_color_format_benchmark) {
+        run_color_format_benchmark = false;
+        color_format_benchmarks.clear();
+        constexpr int warm_up_frame_count = 10;
+        constexpr int timed_frame_count = 100;
+        for (const auto& size : g_color_format_benchmark_sizes) {
+          scene_targets_t output_targets =
+            create_scene_targets(
+              texture_pool, size[0], size[1], color_format_e::rgba8,
+              g_depth_format);
+          for (int f = 0; f < static_cast<int>(color_format_e::count); ++f) {
+            const auto color_format = static_cast<color_format_e>(f);
+            scene_targets_t targets =
+              create_scene_targets(
+                texture_pool, size[0], size[1], color_format, g_depth_format);
+            gpu_timer_t benchmark_scene_timer = create_gpu_timer();
+            gpu_timer_t benchmark_present_timer = create_gpu_timer();
+            for (int frame = 0;
+                 frame < warm_up_frame_count + timed_frame_count; ++frame) {
+              const bool timed = frame >= warm_up_frame_count;
+              begin_streaming_buffer_frame(streaming_buffer);
+              reserve_streaming_buffer(streaming_buffer, frame_streaming_size);
+              if (timed) {
+                begin_gpu_timer(benchmark_scene_timer);
+              }
+              render_scene(targets, nullptr, false);
+              if (timed) {
+                end_gpu_timer(benchmark_scene_timer);
+                begin_gpu_timer(benchmark_present_timer);
+              }
+              present_scene(
+                targets, output_targets.framebuffer, size[0], size[1]);
+              if (timed) {
+                end_gpu_timer(benchmark_present_timer);
+              }
+              end_streaming_buffer_frame(streaming_buffer);
+            }
+            flush_gpu_timer(benchmark_scene_timer);
+            flush_gpu_timer(benchmark_present_timer);
+            color_format_benchmarks.push_back(color_format_benchmark_t{
+              color_format, size[0], size[1],
+              gpu_timer_mean(benchmark_scene_timer),
+              gpu_timer_mean(benchmark_present_timer)});
+            destroy_gpu_timer(benchmark_scene_timer);
+            destroy_gpu_timer(benchmark_present_timer);
+            destroy_scene_targets(texture_pool, targets);
+          }
+          destroy_scene_targets(texture_pool, output_targets);
+        }
+        print_color_format_benchmarks(color_format_benchmarks);
+        if (color_format_benchmark_only) {
+          break;
+        }
+      }
 
-    glUseProgram(main_shader_program);
+      // every depth format with both depth modes from the current camera
+      if (measure_z_fighting) {
+        measure_z_fighting = false;
+        z_fighting_results.clear();
+        const as::mat4 view = as::mat4_from_affine(simulation.camera.view());
+        for (int f = 0; f < static_cast<int>(depth_format_e::count); ++f) {
+          const auto depth_format = static_cast<depth_format_e>(f);
+          for (const depth_mode_e depth_mode :
+               {depth_mode_e::normal, depth_mode_e::reverse}) {
+            const bool reverse_z = depth_mode == depth_mode_e::reverse;
+            const int32_t pixel_count = count_z_fighting_pixels(
+              z_fighting, depth_format, reverse_z,
+              as::mat_mul(
+                view, reverse_z ? reverse_z_perspective_projection
+                                : perspective_projection),
+              vao, instanced_quads.instance_vbo,
+              static_cast<int32_t>(quads.size()));
+            z_fighting_results.push_back(
+              z_fighting_result_t{depth_format, depth_mode, pixel_count});
+            printf(
+              "z-fighting %s %s: %d pixels\n", depth_format_name(depth_format),
+              reverse_z ? "reverse" : "normal", pixel_count);
+          }
+        }
+      }
 
-    const as::mat4 perspective_projection =
-      as::normalize_unit_range(as::perspective_opengl_rh(
-        as::radians(60.0f), float(width) / float(height), near, far));
-    const as::mat4 reverse_z_perspective_projection =
-      as::reverse_z(perspective_projection);
+      // steer the rendered area towards the budget as timings come back
+      if (!g_dynamic_resolution) {
+        render_scale = 1.0f;
+      } else if (scene_timer.sample_count != render_scale_sample_count) {
+        const gpu_timer_t& last_present_timer =
+          gpu_profiler
+            .passes[present_passes[static_cast<int>(
+              resolve_present_mode(g_present_mode, g_render_mode))]]
+            .timer;
+        render_scale = update_render_scale(
+          render_scale, (scene_timer.time + last_present_timer.time) * 1000.0f,
+          g_gpu_budget);
+      }
+      render_scale_sample_count = scene_timer.sample_count;
+      scene_targets.render_width =
+        std::max(int32_t(float(scene_targets.width) * render_scale), 1);
+      scene_targets.render_height =
+        std::max(int32_t(float(scene_targets.height) * render_scale), 1);
+
+      begin_streaming_buffer_frame(streaming_buffer);
+      reserve_streaming_buffer(streaming_buffer, frame_streaming_size);
+
+      {
+        const cpu_zone_t zone("scene");
+        begin_gpu_profiler_pass(gpu_profiler, scene_pass);
+        render_scene(
+          scene_targets, g_occlusion_culling ? &hiz : nullptr, g_late_latch);
+        end_gpu_profiler_pass(gpu_profiler, scene_pass);
+        if (g_late_latch) {
+          glFlush(); // start on the draws while the rest is recorded
+        }
+      }
 
-    if (g_layout_mode != prev_layout_mode) {
-      if (g_layout_mode == layout_mode_e::fighting) {
-        near = 0.01f;
-        far = 10000.0f;
-      } else if (g_layout_mode == layout_mode_e::near) {
-        near = 5.0f;
-        far = 100.0f;
+      // build the depth pyramid for next frame's occlusion test from the
+      // area rendered to (smaller than the targets with dynamic resolution)
+      if (g_quad_mode == quad_mode_e::gpu_culled && g_occlusion_culling) {
+        begin_gpu_profiler_pass(gpu_profiler, hiz_pass);
+        build_hiz(
+          hiz, scene_targets.depth_texture, scene_targets.render_width,
+          scene_targets.render_height, view_projection,
+          g_depth_mode == depth_mode_e::reverse);
+        end_gpu_profiler_pass(gpu_profiler, hiz_pass);
+      } else {
+        hiz.valid = false;
       }
-      prev_layout_mode = g_layout_mode;
-    }
 
-    const as::mat4 view_projection = [camera, perspective_projection,
-                                      reverse_z_perspective_projection] {
-      const as::mat4 view = as::mat4_from_affine(camera.view());
-      if (g_depth_mode == depth_mode_e::normal) {
-        return as::mat_mul(view, perspective_projection);
-      }
-      if (g_depth_mode == depth_mode_e::reverse) {
-        return as::mat_mul(view, reverse_z_perspective_projection);
-      }
-      return as::mat4::identity();
-    }();
-
-    const uint32_t mvp_loc = glGetUniformLocation(main_shader_program, "mvp");
-    const uint32_t color_loc =
-      glGetUniformLocation(main_shader_program, "color");
-
-    switch (g_layout_mode) {
-      case layout_mode_e::fighting: {
-        draw_quad(
-          view_projection,
-          as::mat4_from_mat3_vec3(
-            as::mat3_scale(100.0f, 100.0f, 1.0),
-            as::vec3(-10.0f, 25.0f, -500.02f)),
-          as::vec4(1.0f, 0.5f, 0.2f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection,
-          as::mat4_from_mat3_vec3(
-            as::mat3_scale(100.0f, 100.0f, 1.0),
-            as::vec3(10.0f, -25.0f, -499.98f)),
-          as::vec4(1.0f, 0.0f, 0.0f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection,
-          as::mat4_from_mat3_vec3(
-            as::mat3_scale(100.0f, 100.0f, 1.0),
-            as::vec3(-10.0f, 0.0f, -500.0f)),
-          as::vec4(0.1f, 0.2f, 0.6f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection,
-          as::mat4_from_mat3_vec3(
-            as::mat3_scale(100.0f, 100.0f, 1.0),
-            as::vec3(10.0f, 0.0f, -500.01f)),
-          as::vec4(0.1f, 0.8f, 0.2f, 1.0f), mvp_loc, color_loc, vao);
-      } break;
-      case layout_mode_e::near: {
-        draw_quad(
-          view_projection, as::mat4_from_vec3(as::vec3(-0.25f, 0.25f, -1.0f)),
-          as::vec4(1.0f, 0.5f, 0.2f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection, as::mat4_from_vec3(as::vec3(0.25f, -0.25f, -3.0f)),
-          as::vec4(1.0f, 0.0f, 0.0f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection, as::mat4_from_vec3(as::vec3(-0.25f, 5.5f, -20.0f)),
-          as::vec4(0.1f, 0.2f, 0.6f, 1.0f), mvp_loc, color_loc, vao);
-        draw_quad(
-          view_projection, as::mat4_from_vec3(as::vec3(-30.0f, 0.0f, -80.0f)),
-          as::vec4(0.1f, 0.8f, 0.2f, 1.0f), mvp_loc, color_loc, vao);
-      } break;
-    }
+      const int32_t present_pass = present_passes[static_cast<int>(
+        resolve_present_mode(g_present_mode, g_render_mode))];
+      {
+        const cpu_zone_t zone("present");
+        begin_gpu_profiler_pass(gpu_profiler, present_pass);
+        present_scene(scene_targets, 0, width, height);
+        end_gpu_profiler_pass(gpu_profiler, present_pass);
+      }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      gl_state_use_program(main_shader_program.id);
 
-    glDisable(GL_DEPTH_TEST);
+      {
+        const cpu_zone_t zone("imgui new frame");
+        ImGui_ImplOpenGL3_NewFrame();
+        {
+          const std::lock_guard<std::mutex> lock(imgui_platform_mutex);
+          ImGui_ImplSDL2_NewFrameFromInputs(&imgui_inputs);
+        }
+        ImGui::NewFrame();
+      }
+      const uint64_t widgets_begin = cpu_profiler_now();
+      begin_stats_text(ui_stats, g_retained_ui, delta_time);
+
+      {
+        int depth_mode_index = static_cast<int>(g_depth_mode);
+        const char* depth_mode_names[] = {"Normal", "Reverse"};
+        ImGui::Combo(
+          "Depth Mode", &depth_mode_index, depth_mode_names,
+          std::size(depth_mode_names));
+        g_depth_mode = static_cast<depth_mode_e>(depth_mode_index);
+      }
 
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+      {
+        int render_mode_index = static_cast<int>(g_render_mode);
+        const char* render_mode_names[] = {"Color", "Depth"};
+        ImGui::Combo(
+          "Render Mode", &render_mode_index, render_mode_names,
+          std::size(render_mode_names));
+        g_render_mode = static_cast<render_mode_e>(render_mode_index);
+      }
 
-    if (g_render_mode == render_mode_e::color) {
-      glUseProgram(screen_shader_program);
-    } else {
-      glUseProgram(depth_screen_shader_program);
-      const uint32_t near_loc =
-        glGetUniformLocation(depth_screen_shader_program, "near");
-      glUniform1f(near_loc, near);
-      const uint32_t far_loc =
-        glGetUniformLocation(depth_screen_shader_program, "far");
-      glUniform1f(far_loc, far);
-    }
+      {
+        int present_mode_index = static_cast<int>(g_present_mode);
+        const char* present_mode_names[] = {"Quad", "Triangle", "Blit"};
+        ImGui::Combo(
+          "Present Mode", &present_mode_index, present_mode_names,
+          std::size(present_mode_names));
+        g_present_mode = static_cast<present_mode_e>(present_mode_index);
+      }
 
-    glBindVertexArray(quad_vao);
+      {
+        int layout_mode_index = static_cast<int>(g_layout_mode);
+        const char* layout_mode_names[] = {"Near", "Fighting", "Stress"};
+        ImGui::Combo(
+          "Layout Mode", &layout_mode_index, layout_mode_names,
+          std::size(layout_mode_names));
+        g_layout_mode = static_cast<layout_mode_e>(layout_mode_index);
+      }
 
-    if (g_render_mode == render_mode_e::color) {
-      glBindTexture(GL_TEXTURE_2D, texture_colorbuffer);
-    } else {
-      glBindTexture(GL_TEXTURE_2D, texture_depth_stencil_buffer);
-    }
+      if (ImGui::CollapsingHeader("GPU Profiler")) {
+        for (const gpu_profiler_pass_t& pass : gpu_profiler.passes) {
+          char overlay[64];
+          std::snprintf(
+            overlay, sizeof(overlay), "%.3f ms", pass.timer.time * 1000.0f);
+          ImGui::PlotLines(
+            pass.name, pass.history.data(), gpu_profiler.history_size,
+            gpu_profiler.history_offset, overlay, 0.0f, FLT_MAX,
+            ImVec2(0.0f, 40.0f));
+        }
+        if (ImGui::Button("Write CSV")) {
+          gpu_profile_written =
+            write_gpu_profiler_csv(gpu_profiler, gpu_profile_path);
+          printf(
+            "%s %s\n", gpu_profile_written ? "wrote" : "failed to write",
+            gpu_profile_path);
+        }
+        if (gpu_profile_written) {
+          ImGui::SameLine();
+          ImGui::TextUnformatted(gpu_profile_path);
+        }
+      }
 
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+      {
+        int quad_mode_index = static_cast<int>(g_quad_mode);
+        const char* quad_mode_names[] = {
+          "Individual", "Instanced", "Indirect", "GPU Culled"};
+        ImGui::Combo(
+          "Quad Mode", &quad_mode_index, quad_mode_names,
+          std::size(quad_mode_names));
+        g_quad_mode = static_cast<quad_mode_e>(quad_mode_index);
+      }
 
-    glUseProgram(main_shader_program);
+      {
+        int color_format_index = static_cast<int>(g_color_format);
+        const char* color_format_names[] = {
+          "RGBA8", "RGB10A2", "R11G11B10F", "RGBA16F", "RGBA32F"};
+        ImGui::Combo(
+          "Color Format", &color_format_index, color_format_names,
+          std::size(color_format_names));
+        g_color_format = static_cast<color_format_e>(color_format_index);
+      }
 
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
-    ImGui::NewFrame();
+      {
+        int depth_format_index = static_cast<int>(g_depth_format);
+        const char* depth_format_names[] = {
+          "D16", "D24", "D24S8", "D32F", "D32FS8"};
+        ImGui::Combo(
+          "Depth Format", &depth_format_index, depth_format_names,
+          std::size(depth_format_names));
+        g_depth_format = static_cast<depth_format_e>(depth_format_index);
+      }
 
-    {
-      int depth_mode_index = static_cast<int>(g_depth_mode);
-      const char* depth_mode_names[] = {"Normal", "Reverse"};
-      ImGui::Combo(
-        "Depth Mode", &depth_mode_index, depth_mode_names,
-        std::size(depth_mode_names));
-      g_depth_mode = static_cast<depth_mode_e>(depth_mode_index);
+      if (
+        g_color_format != scene_targets.color_format
+        || g_depth_format != scene_targets.depth_format) {
+        const int32_t targets_width = scene_targets.width;
+        const int32_t targets_height = scene_targets.height;
+        destroy_scene_targets(texture_pool, scene_targets);
+        scene_targets = create_scene_targets(
+          texture_pool, targets_width, targets_height, g_color_format,
+          g_depth_format);
+      }
+
+      {
+        const char* stress_quad_count_names[] = {"1K", "100K", "1M"};
+        ImGui::Combo(
+          "Stress Quads", &g_stress_quad_count_index, stress_quad_count_names,
+          std::size(stress_quad_count_names));
+      }
+
+      {
+        int pacing_mode_index = static_cast<int>(g_pacing_mode);
+        const char* pacing_mode_names[] = {
+          "VSync", "Adaptive VSync", "Uncapped", "Limited"};
+        ImGui::Combo(
+          "Frame Pacing", &pacing_mode_index, pacing_mode_names,
+          std::size(pacing_mode_names));
+        g_pacing_mode = static_cast<pacing_mode_e>(pacing_mode_index);
+        if (g_pacing_mode != frame_pacer.mode) {
+          set_frame_pacing_mode(frame_pacer, g_pacing_mode);
+        }
+        if (g_pacing_mode == pacing_mode_e::limited) {
+          ImGui::SliderFloat(
+            "Target Rate (Hz)", &frame_pacer.target_rate, 24.0f, 240.0f);
+        }
+      }
+
+      ImGui::Checkbox("CPU Culling", &g_cpu_culling);
+      if (ImGui::Checkbox("Single Threaded Jobs", &g_single_threaded_jobs)) {
+        destroy_job_system(job_system);
+        job_system = create_job_system(
+          g_single_threaded_jobs ? 0 : default_job_worker_count());
+      }
+      ImGui::Checkbox("Occlusion Culling (GPU Culled)", &g_occlusion_culling);
+      if (
+        ImGui::Checkbox("ImGui Persistent Buffers", &g_imgui_persistent_buffers)
+        && !ImGui_ImplOpenGL3_SetUsePersistentBuffers(
+          g_imgui_persistent_buffers)) {
+        g_imgui_persistent_buffers = false; // not supported by the context
+      }
+      if (
+        ImGui::Checkbox(
+          "ImGui Persistent VAO", &g_imgui_persistent_vertex_arrays)
+        && !ImGui_ImplOpenGL3_SetUsePersistentVertexArrays(
+          g_imgui_persistent_vertex_arrays)) {
+        g_imgui_persistent_vertex_arrays = false;
+      }
+      if (
+        ImGui::Checkbox("ImGui Alpha8 Font Atlas", &g_imgui_alpha8_fonts)
+        && !ImGui_ImplOpenGL3_SetUseAlpha8FontsTexture(g_imgui_alpha8_fonts)) {
+        g_imgui_alpha8_fonts = false;
+      }
+      ImGui::Checkbox("Retained UI", &g_retained_ui);
+      {
+        const bool late_latch_changed =
+          ImGui::Checkbox("Late Latch Camera", &g_late_latch);
+        const bool measure_latency_changed =
+          ImGui::Checkbox("Measure Latency", &g_measure_latency);
+        // restart the measurement so each setting gets its own mean
+        if (late_latch_changed || measure_latency_changed) {
+          reset_latency_meter(latency_meter);
+        }
+      }
+      ImGui::Checkbox("Dynamic Resolution", &g_dynamic_resolution);
+      if (g_dynamic_resolution) {
+        ImGui::SliderFloat("GPU Budget (ms)", &g_gpu_budget, 1.0f, 33.0f);
+      }
+
+      ImGui::SliderFloat("Near Plane", &near, 0.01f, 49.9f);
+      ImGui::SliderFloat("Far Plane", &far, 50.0f, 10000.0f);
+
+      stats_text(
+        ui_stats, "Frame time: %.3f ms (%zu quads)", delta_time * 1000.0f,
+        quads.size());
+      stats_text(
+        ui_stats, "Frame pacing: %s%s, %.3f ms mean, %.3f ms max",
+        pacing_mode_name(frame_pacer.mode),
+        frame_pacer.adaptive_fallback ? " (unsupported, vsync)" : "",
+        frame_pacer.mean, frame_pacer.max);
+      stats_text(
+        ui_stats, "Frame jitter: %.3f ms std dev, %.3f ms frame to frame",
+        frame_pacer.jitter, frame_pacer.frame_to_frame);
+      stats_text(
+        ui_stats, "Main thread: %.3f ms per tick, %.3f ms max between polls",
+        simulation.tick_time * 1000.0f, simulation.poll_gap_max * 1000.0f);
+      stats_text(
+        ui_stats, "Render thread: %.3f ms per frame, %.3f ms in swap",
+        delta_time * 1000.0f, swap_time * 1000.0f);
+      if (frame_pacer.mode == pacing_mode_e::limited) {
+        stats_text(
+          ui_stats, "Limiter wait: %.3f ms", frame_pacer.wait_time * 1000.0f);
+      }
+      if (g_cpu_culling) {
+        stats_text(
+          ui_stats, "CPU visible: %zu (%.3f ms, %s, %d threads)",
+          visible_quads.size(), cpu_cull_time * 1000.0f,
+          cull_spheres_implementation(), job_system_thread_count(job_system));
+      }
+      if (g_quad_mode == quad_mode_e::gpu_culled) {
+        stats_text(ui_stats, "GPU visible: %d", gpu_culling.visible_count);
+      }
+      stats_text(
+        ui_stats, "GPU scene pass: %.3f ms (%s, %s), present pass: %.3f ms",
+        scene_timer.time * 1000.0f,
+        color_format_name(scene_targets.color_format),
+        depth_format_name(scene_targets.depth_format),
+        gpu_profiler.passes[present_pass].timer.time * 1000.0f);
+      stats_text(
+        ui_stats,
+        "GPU present pass mean: quad %.3f, triangle %.3f, blit %.3f ms",
+        gpu_timer_mean(gpu_profiler.passes[present_passes[0]].timer) * 1000.0f,
+        gpu_timer_mean(gpu_profiler.passes[present_passes[1]].timer) * 1000.0f,
+        gpu_timer_mean(gpu_profiler.passes[present_passes[2]].timer) * 1000.0f);
+      stats_text(
+        ui_stats, "Drawable: %dx%d, targets: %dx%d (%d reallocations)", width,
+        height, scene_targets.width, scene_targets.height, resize_count);
+      if (g_dynamic_resolution) {
+        stats_text(
+          ui_stats, "Render scale: %.2f (%dx%d)", render_scale,
+          scene_targets.render_width, scene_targets.render_height);
+      }
+      stats_text(
+        ui_stats,
+        "Texture pool: %d textures, %d reused, %d allocated, %d evicted",
+        static_cast<int>(texture_pool.textures.size()),
+        static_cast<int>(texture_pool.hit_count),
+        static_cast<int>(texture_pool.miss_count),
+        static_cast<int>(texture_pool.evict_count));
+      stats_text(
+        ui_stats, "Shader string lookups per frame: %d", string_lookups);
+      {
+        int font_texture_size = 0;
+        float font_texture_convert_time = 0.0f;
+        float font_texture_upload_time = 0.0f;
+        ImGui_ImplOpenGL3_GetFontsTextureStats(
+          &font_texture_size, &font_texture_convert_time,
+          &font_texture_upload_time);
+        stats_text(
+          ui_stats, "Font atlas: %d KB, convert %.3f ms, upload %.3f ms",
+          font_texture_size / 1024, font_texture_convert_time,
+          font_texture_upload_time);
+      }
+      stats_text(
+        ui_stats, "GL state changes per frame: %d issued, %d elided",
+        static_cast<int>(frame_gl_state_stats.issued),
+        static_cast<int>(frame_gl_state_stats.elided));
+      stats_text(
+        ui_stats, "GL state queries per frame: %d shadowed, %d forwarded",
+        static_cast<int>(frame_gl_state_stats.queries_shadowed),
+        static_cast<int>(frame_gl_state_stats.queries_forwarded));
+      stats_text(
+        ui_stats,
+        "Streaming buffer: %d KB x %d, %d stalls (%.3f ms total), %d resizes",
+        static_cast<int>(streaming_buffer.region_size / 1024),
+        streaming_buffer.region_count, streaming_buffer.stall_count,
+        streaming_buffer.total_wait_time * 1000.0f,
+        streaming_buffer.resize_count);
+      stats_text(
+        ui_stats, "Streaming buffer wait: %.3f ms",
+        streaming_buffer.wait_time * 1000.0f);
+      if (g_measure_latency) {
+        stats_text(
+          ui_stats,
+          "Input to GPU completion: %.3f ms (mean %.3f ms, %d frames)",
+          latency_meter.latency * 1000.0f,
+          latency_meter_mean(latency_meter) * 1000.0f,
+          static_cast<int>(latency_meter.sample_count));
+      }
+      if (g_retained_ui) {
+        stats_text(
+          ui_stats, "Retained UI: %d hits, %d misses",
+          static_cast<int>(ui_cache.hit_count),
+          static_cast<int>(ui_cache.miss_count));
+      }
+
+      if (ImGui::Button("Run Color Format Benchmark")) {
+        run_color_format_benchmark = true; // next frame, before the scene
+      }
+      for (const color_format_benchmark_t& benchmark :
+           color_format_benchmarks) {
+        ImGui::Text(
+          "%s %dx%d: scene %.3f ms, present %.3f ms",
+          color_format_name(benchmark.color_format), benchmark.width,
+          benchmark.height, benchmark.scene_time * 1000.0f,
+          benchmark.present_time * 1000.0f);
+      }
+
+      if (g_layout_mode == layout_mode_e::fighting) {
+        if (ImGui::Button("Measure Z-Fighting")) {
+          measure_z_fighting = true; // next frame, before the scene
+        }
+        for (const z_fighting_result_t& result : z_fighting_results) {
+          ImGui::Text(
+            "%s %s: %d z-fighting pixels",
+            depth_format_name(result.depth_format),
+            result.depth_mode == depth_mode_e::reverse ? "Reverse" : "Normal",
+            result.pixel_count);
+        }
+      }
+
+      record_cpu_zone("imgui widgets", widgets_begin, cpu_profiler_now());
+
+      {
+        const cpu_zone_t zone("imgui render");
+        ImGui::Render();
+        {
+          const std::lock_guard<std::mutex> lock(imgui_platform_mutex);
+          ImGui_ImplSDL2_RecordOutputs(&imgui_outputs);
+        }
+        begin_gpu_profiler_pass(gpu_profiler, ui_pass);
+        if (g_retained_ui) {
+          render_ui_cached(ui_cache, ImGui::GetDrawData());
+        } else {
+          ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        end_gpu_profiler_pass(gpu_profiler, ui_pass);
+      }
+      end_gpu_profiler_frame(gpu_profiler);
+      end_latency_meter_frame(
+        latency_meter, g_measure_latency ? input_time : -1);
+
+      end_streaming_buffer_frame(streaming_buffer);
+      trim_texture_pool(texture_pool);
+
+      string_lookups =
+        static_cast<int>(shader_string_lookup_count() - string_lookup_count);
+      const gl_state_stats_t gl_state_stats_end = gl_state_stats();
+      frame_gl_state_stats = gl_state_stats_t{
+        gl_state_stats_end.issued - gl_state_stats_begin.issued,
+        gl_state_stats_end.elided - gl_state_stats_begin.elided,
+        gl_state_stats_end.queries_shadowed
+          - gl_state_stats_begin.queries_shadowed,
+        gl_state_stats_end.queries_forwarded
+          - gl_state_stats_begin.queries_forwarded};
+
+      {
+        const cpu_zone_t zone("pace");
+        wait_frame_pacer(frame_pacer);
+      }
+      {
+        const cpu_zone_t zone("swap");
+        const auto swap_begin = std::chrono::steady_clock::now();
+        SDL_GL_SwapWindow(window);
+        swap_time = std::chrono::duration_cast<fp_seconds>(
+                      std::chrono::steady_clock::now() - swap_begin)
+                      .count();
+      }
+
+      if (frame_bench_only) {
+        gpu_timer_t& bench_scene_timer = gpu_profiler.passes[scene_pass].timer;
+        gpu_timer_t& bench_present_timer =
+          gpu_profiler.passes[present_pass].timer;
+        if (frame_bench_frame >= g_frame_bench_warm_up_frame_count) {
+          frame_bench_cpu_times.push_back(
+            std::chrono::duration<float, std::milli>(
+              std::chrono::steady_clock::now() - frame_begin)
+              .count());
+        }
+        // the timers resolve a few frames late and not one per frame, so
+        // every result of the timed frames is kept and they're paired up at
+        // the end, the warm up results are read back before keeping starts
+        if (++frame_bench_frame == g_frame_bench_warm_up_frame_count) {
+          for (gpu_timer_t* timer :
+               {&bench_scene_timer, &bench_present_timer}) {
+            flush_gpu_timer(*timer);
+            timer->results.clear();
+            timer->keep_results = true;
+          }
+        }
+        if (
+          frame_bench_frame
+          == g_frame_bench_warm_up_frame_count + frame_bench_frame_count) {
+          for (gpu_timer_t* timer :
+               {&bench_scene_timer, &bench_present_timer}) {
+            flush_gpu_timer(*timer);
+            timer->keep_results = false;
+          }
+          const size_t gpu_frame_count = std::min(
+            bench_scene_timer.results.size(),
+            bench_present_timer.results.size());
+          for (size_t i = 0; i < gpu_frame_count; ++i) {
+            frame_bench_gpu_times.push_back(
+              (bench_scene_timer.results[i] + bench_present_timer.results[i])
+              * 1000.0f);
+          }
+          bench_scene_timer.results.clear();
+          bench_present_timer.results.clear();
+          frame_bench_results.push_back(frame_bench_result_t{
+            g_frame_bench_layout_mode_names[static_cast<int>(g_layout_mode)],
+            g_frame_bench_depth_mode_names[static_cast<int>(g_depth_mode)],
+            g_frame_bench_render_mode_names[static_cast<int>(g_render_mode)],
+            frame_bench_frame_count, frame_time_stats(frame_bench_cpu_times),
+            frame_time_stats(frame_bench_gpu_times)});
+          frame_bench_cpu_times.clear();
+          frame_bench_gpu_times.clear();
+          frame_bench_frame = 0;
+          if (++frame_bench_combination == g_frame_bench_combination_count) {
+            print_frame_bench_results(frame_bench_results);
+            const std::string path(frame_bench_path);
+            const bool json = path.size() >= 5
+                           && path.compare(path.size() - 5, 5, ".json") == 0;
+            const bool written =
+              json ? write_frame_bench_json(frame_bench_results, path.c_str())
+                   : write_frame_bench_csv(frame_bench_results, path.c_str());
+            printf(
+              "%s %s\n", written ? "wrote" : "failed to write", path.c_str());
+            exit_code = written ? 0 : 1;
+            quit = true;
+          }
+        }
+      }
     }
+    // a benchmark that ended the loop stops the main thread as well
+    quit = true;
+    SDL_GL_MakeCurrent(window, nullptr);
+  };
 
-    {
-      int render_mode_index = static_cast<int>(g_render_mode);
-      const char* render_mode_names[] = {"Color", "Depth"};
-      ImGui::Combo(
-        "Render Mode", &render_mode_index, render_mode_names,
-        std::size(render_mode_names));
-      g_render_mode = static_cast<render_mode_e>(render_mode_index);
+  // the context can only be current on one thread at a time
+  SDL_GL_MakeCurrent(window, nullptr);
+  // so the first frame has a display size
+  ImGui_ImplSDL2_RecordFrame(&imgui_outputs, &imgui_inputs);
+  std::thread render_thread(render_loop);
+
+  // the main thread only handles events and steps the camera, waiting for
+  // events in between ticks, so a swap blocking the render thread doesn't
+  // hold up input
+  const auto tick_period =
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<float>(1.0f / g_simulation_rate));
+  auto next_tick = std::chrono::steady_clock::now();
+  auto camera_step_time = next_tick;
+  auto poll_time = next_tick;
+  float poll_gap_max = 0.0f; // seconds, over the current second
+  float previous_poll_gap_max = 0.0f;
+  int64_t tick_count = 0;
+  // when the newest mouse motion happened (cpu_profiler_now ns)
+  int64_t input_time = -1;
+  auto resize_time = std::chrono::steady_clock::time_point{};
+  int64_t trace_request_count = 0;
+  std::vector<SDL_Event> pending_events;
+  while (!quit) {
+    const auto timeout = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        next_tick - std::chrono::steady_clock::now()),
+      std::chrono::milliseconds(0));
+    SDL_Event current_event;
+    bool has_event =
+      SDL_WaitEventTimeout(&current_event, static_cast<int>(timeout.count()))
+      != 0;
+
+    const cpu_zone_t zone("tick");
+    const auto tick_begin = std::chrono::steady_clock::now();
+    poll_gap_max = std::max(
+      poll_gap_max,
+      std::chrono::duration_cast<fp_seconds>(tick_begin - poll_time).count());
+    poll_time = tick_begin;
+
+    for (; has_event; has_event = SDL_PollEvent(&current_event) != 0) {
+      if (current_event.type == SDL_QUIT) {
+        quit = true;
+      }
+      if (current_event.type == SDL_MOUSEMOTION) {
+        // event timestamps are sdl ticks (ms), taken back from now
+        const uint32_t age = SDL_GetTicks() - current_event.common.timestamp;
+        input_time = static_cast<int64_t>(cpu_profiler_now())
+                   - int64_t(age) * 1'000'000;
+      }
+      if (
+        current_event.type == SDL_WINDOWEVENT
+        && current_event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        resize_time = tick_begin;
+      }
+      if (
+        current_event.type == SDL_KEYDOWN
+        && current_event.key.keysym.sym == SDLK_F9) {
+        trace_request_count++;
+      }
+      camera_system.handleEvents(asci_sdl::sdlToInput(&current_event));
+      pending_events.push_back(current_event);
+    }
+    if (!pending_events.empty()) {
+      const std::lock_guard<std::mutex> lock(imgui_platform_mutex);
+      for (const SDL_Event& pending_event : pending_events) {
+        ImGui_ImplSDL2_RecordEvent(&pending_event, &imgui_inputs);
+      }
+    }
+    pending_events.clear();
+
+    if (tick_begin < next_tick) {
+      continue;
+    }
+    // more than a tick behind starts over from now instead of catching up
+    next_tick += tick_period;
+    if (next_tick < tick_begin) {
+      next_tick = tick_begin + tick_period;
     }
 
+    const float camera_delta_time =
+      std::chrono::duration_cast<fp_seconds>(tick_begin - camera_step_time)
+        .count();
+    camera_step_time = tick_begin;
+    {
+      const cpu_zone_t step_zone("step camera");
+      target_camera =
+        camera_system.stepCamera(target_camera, camera_delta_time);
+    }
     {
-      int layout_mode_index = static_cast<int>(g_layout_mode);
-      const char* layout_mode_names[] = {"Near", "Fighting"};
-      ImGui::Combo(
-        "Layout Mode", &layout_mode_index, layout_mode_names,
-        std::size(layout_mode_names));
-      g_layout_mode = static_cast<layout_mode_e>(layout_mode_index);
+      const cpu_zone_t smooth_zone("smooth camera");
+      camera = asci::smoothCamera(
+        camera, target_camera, asci::SmoothProps{}, camera_delta_time);
     }
 
-    ImGui::SliderFloat("Near Plane", &near, 0.01f, 49.9f);
-    ImGui::SliderFloat("Far Plane", &far, 50.0f, 10000.0f);
+    if (++tick_count % static_cast<int64_t>(g_simulation_rate) == 0) {
+      previous_poll_gap_max = poll_gap_max;
+      poll_gap_max = 0.0f;
+    }
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+      const std::lock_guard<std::mutex> lock(imgui_platform_mutex);
+      ImGui_ImplSDL2_RecordFrame(&imgui_outputs, &imgui_inputs);
+    }
 
-    SDL_GL_SwapWindow(window);
+    simulation_state_t& state = triple_buffer_back(simulation_states);
+    state.camera = camera;
+    SDL_GL_GetDrawableSize(
+      window, &state.drawable_width, &state.drawable_height);
+    state.resize_time = resize_time;
+    state.trace_request_count = trace_request_count;
+    state.input_time = input_time;
+    state.tick_time = std::chrono::duration_cast<fp_seconds>(
+                        std::chrono::steady_clock::now() - tick_begin)
+                        .count();
+    state.poll_gap_max = previous_poll_gap_max;
+    publish_triple_buffer(simulation_states);
   }
 
-  glDeleteVertexArrays(1, &vao);
-  glDeleteVertexArrays(1, &quad_vao);
-  glDeleteBuffers(1, &vbo);
-  glDeleteBuffers(1, &quad_vbo);
-  glDeleteBuffers(1, &ebo);
-  glDeleteProgram(main_shader_program);
-  glDeleteProgram(screen_shader_program);
-  glDeleteProgram(depth_screen_shader_program);
-  glDeleteTextures(1, &texture_colorbuffer);
-  glDeleteTextures(1, &texture_depth_stencil_buffer);
-  glDeleteFramebuffers(1, &framebuffer);
+  render_thread.join();
+  SDL_GL_MakeCurrent(window, context);
+
+  destroy_job_system(job_system);
+  destroy_latency_meter(latency_meter);
+  destroy_z_fighting(z_fighting);
+  destroy_gpu_profiler(gpu_profiler);
+  destroy_ui_cache(ui_cache);
+  destroy_streaming_buffer(streaming_buffer);
+  destroy_hiz(hiz);
+  destroy_gpu_culling(gpu_culling);
+  destroy_draw_commands(draw_commands);
+  destroy_instanced_quads(instanced_quads);
+
+  gl_state_delete_vertex_arrays(1, &vao);
+  gl_state_delete_vertex_arrays(1, &quad_vao);
+  gl_state_delete_vertex_arrays(1, &empty_vao);
+  gl_state_delete_buffers(1, &vbo);
+  gl_state_delete_buffers(1, &quad_vbo);
+  gl_state_delete_buffers(1, &ebo);
+  destroy_shader(main_shader_program);
+  destroy_shader(screen_shader_program);
+  destroy_shader(depth_screen_shader_program);
+  destroy_shader(triangle_screen_shader_program);
+  destroy_shader(triangle_depth_screen_shader_program);
+  destroy_scene_targets(texture_pool, scene_targets);
+  destroy_texture_pool(texture_pool);
 
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplSDL2_Shutdown();
@@ -534,5 +1901,5 @@ int main(int argc, char** argv)
   SDL_DestroyWindow(window);
   SDL_Quit();
 
-  return 0;
+  return exit_code;
 }
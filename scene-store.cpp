@@ -0,0 +1,162 @@
+#include "scene-store.hpp"
+
+#include "instanced-quads.hpp"
+#include "job-system.hpp"
+
+#include <algorithm>
+
+// entities per job when building the quads
+constexpr int64_t g_scene_chunk_size = 16 * 1024;
+
+size_t scene_entity_count(const scene_store_t& scene)
+{
+  return scene.position.size();
+}
+
+static uint32_t acquire_slot(scene_store_t& scene, const uint32_t index)
+{
+  if (scene.free_slot == g_scene_invalid_index) {
+    scene.slot_index.push_back(index);
+    scene.slot_generation.push_back(0);
+    return static_cast<uint32_t>(scene.slot_index.size() - 1);
+  }
+  const uint32_t slot = scene.free_slot;
+  scene.free_slot = scene.slot_index[slot];
+  scene.slot_index[slot] = index;
+  return slot;
+}
+
+static void release_slot(scene_store_t& scene, const uint32_t slot)
+{
+  scene.slot_generation[slot]++; // outstanding handles no longer match
+  scene.slot_index[slot] = scene.free_slot;
+  scene.free_slot = slot;
+}
+
+scene_handle_t add_scene_entity(
+  scene_store_t& scene, const as::vec3& position, const as::vec3& scale,
+  const as::vec4& color, const uint32_t flags)
+{
+  const size_t index = add_scene_entities(scene, 1);
+  scene.position[index] = position;
+  scene.scale[index] = scale;
+  scene.color[index] = color;
+  scene.flags[index] = flags;
+  return scene_entity_handle(scene, index);
+}
+
+size_t add_scene_entities(scene_store_t& scene, const size_t count)
+{
+  const size_t first = scene_entity_count(scene);
+  scene.position.resize(first + count, as::vec3(0.0f, 0.0f, 0.0f));
+  scene.scale.resize(first + count, as::vec3(1.0f, 1.0f, 1.0f));
+  scene.color.resize(first + count, as::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+  scene.flags.resize(first + count, 0);
+  scene.slot.resize(first + count);
+  for (size_t i = first; i < first + count; ++i) {
+    scene.slot[i] = acquire_slot(scene, static_cast<uint32_t>(i));
+  }
+  return first;
+}
+
+bool remove_scene_entity(scene_store_t& scene, const scene_handle_t handle)
+{
+  const uint32_t index = scene_entity_index(scene, handle);
+  if (index == g_scene_invalid_index) {
+    return false;
+  }
+
+  // fill the gap with the last entity
+  const size_t last = scene_entity_count(scene) - 1;
+  scene.position[index] = scene.position[last];
+  scene.scale[index] = scene.scale[last];
+  scene.color[index] = scene.color[last];
+  scene.flags[index] = scene.flags[last];
+  scene.slot[index] = scene.slot[last];
+  scene.slot_index[scene.slot[index]] = index;
+
+  scene.position.pop_back();
+  scene.scale.pop_back();
+  scene.color.pop_back();
+  scene.flags.pop_back();
+  scene.slot.pop_back();
+  release_slot(scene, handle.slot);
+  return true;
+}
+
+void clear_scene(scene_store_t& scene)
+{
+  for (const uint32_t slot : scene.slot) {
+    release_slot(scene, slot);
+  }
+  scene.position.clear();
+  scene.scale.clear();
+  scene.color.clear();
+  scene.flags.clear();
+  scene.slot.clear();
+}
+
+uint32_t scene_entity_index(
+  const scene_store_t& scene, const scene_handle_t handle)
+{
+  if (
+    handle.slot >= scene.slot_generation.size()
+    || scene.slot_generation[handle.slot] != handle.generation) {
+    return g_scene_invalid_index;
+  }
+  return scene.slot_index[handle.slot];
+}
+
+scene_handle_t scene_entity_handle(
+  const scene_store_t& scene, const size_t index)
+{
+  const uint32_t slot = scene.slot[index];
+  return scene_handle_t{slot, scene.slot_generation[slot]};
+}
+
+void quads_from_scene(
+  job_system_t& job_system, const scene_store_t& scene,
+  std::vector<quad_instance_t>& quads)
+{
+  const auto count = static_cast<int64_t>(scene_entity_count(scene));
+  const int64_t chunk_count =
+    (count + g_scene_chunk_size - 1) / g_scene_chunk_size;
+
+  // visible entities per chunk then where each chunk starts in quads
+  std::vector<size_t> chunk_offsets(chunk_count + 1, 0);
+  parallel_for(
+    job_system, chunk_count, 1, [&](const int64_t begin, const int64_t end) {
+      for (int64_t chunk = begin; chunk < end; ++chunk) {
+        const auto flags = scene.flags.begin();
+        const auto first = flags + chunk * g_scene_chunk_size;
+        const auto last =
+          flags + std::min(count, (chunk + 1) * g_scene_chunk_size);
+        chunk_offsets[chunk + 1] =
+          std::count_if(first, last, [](const uint32_t flags) {
+            return (flags & g_scene_flag_hidden) == 0;
+          });
+      }
+    });
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+
+  quads.resize(chunk_offsets.back());
+  parallel_for(
+    job_system, chunk_count, 1, [&](const int64_t begin, const int64_t end) {
+      for (int64_t chunk = begin; chunk < end; ++chunk) {
+        size_t quad = chunk_offsets[chunk];
+        const int64_t last =
+          std::min(count, (chunk + 1) * g_scene_chunk_size);
+        for (int64_t i = chunk * g_scene_chunk_size; i < last; ++i) {
+          if ((scene.flags[i] & g_scene_flag_hidden) != 0) {
+            continue;
+          }
+          quads[quad++] = quad_instance_t{
+            as::mat4_from_mat3_vec3(
+              as::mat3_scale(scene.scale[i]), scene.position[i]),
+            scene.color[i]};
+        }
+      }
+    });
+}
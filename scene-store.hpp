@@ -0,0 +1,67 @@
+#pragma once
+
+#include <as/as-math-ops.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct job_system_t;
+struct quad_instance_t;
+
+constexpr uint32_t g_scene_invalid_index = ~0u;
+
+// identifies an entity for as long as it exists, a handle to a removed
+// entity stays invalid even once its slot is reused (see generation)
+struct scene_handle_t
+{
+  uint32_t slot = g_scene_invalid_index;
+  uint32_t generation = 0;
+};
+
+// entity flags
+constexpr uint32_t g_scene_flag_hidden = 1u << 0; // not drawn or culled
+
+// entities stored as separate dense arrays (entity i is element i of each),
+// removal moves the last entity into the gap so the arrays stay packed,
+// handles go through a slot table to find where an entity currently lives
+struct scene_store_t
+{
+  std::vector<as::vec3> position;
+  std::vector<as::vec3> scale;
+  std::vector<as::vec4> color;
+  std::vector<uint32_t> flags;
+  std::vector<uint32_t> slot; // slot of each dense entity
+
+  // indexed by handle slot, the dense index (or the next free slot)
+  std::vector<uint32_t> slot_index;
+  std::vector<uint32_t> slot_generation;
+  uint32_t free_slot = g_scene_invalid_index; // head of the free list
+};
+
+size_t scene_entity_count(const scene_store_t& scene);
+
+scene_handle_t add_scene_entity(
+  scene_store_t& scene, const as::vec3& position, const as::vec3& scale,
+  const as::vec4& color, uint32_t flags = 0);
+
+// appends count entities with unit scale and returns the dense index of the
+// first, for filling the arrays in bulk (handles come from scene_entity_handle)
+size_t add_scene_entities(scene_store_t& scene, size_t count);
+
+// returns false if the handle was already invalid
+bool remove_scene_entity(scene_store_t& scene, scene_handle_t handle);
+
+// removes every entity and invalidates every handle
+void clear_scene(scene_store_t& scene);
+
+// dense index of the entity or g_scene_invalid_index, only valid until the
+// next removal
+uint32_t scene_entity_index(const scene_store_t& scene, scene_handle_t handle);
+scene_handle_t scene_entity_handle(const scene_store_t& scene, size_t index);
+
+// fills quads with the visible entities in dense order, the model matrix is
+// built from position and scale on the job system
+void quads_from_scene(
+  job_system_t& job_system, const scene_store_t& scene,
+  std::vector<quad_instance_t>& quads);
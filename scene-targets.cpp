@@ -0,0 +1,157 @@
+#include "scene-targets.hpp"
+
+#include "texture-pool.hpp"
+
+#include <glad/gl.h>
+
+#include <iostream>
+
+uint32_t color_format_internal_format(const color_format_e color_format)
+{
+  switch (color_format) {
+    case color_format_e::rgba8:
+      return GL_RGBA8;
+    case color_format_e::rgb10a2:
+      return GL_RGB10_A2;
+    case color_format_e::r11g11b10f:
+      return GL_R11F_G11F_B10F;
+    case color_format_e::rgba16f:
+      return GL_RGBA16F;
+    case color_format_e::rgba32f:
+    default:
+      return GL_RGBA32F;
+  }
+}
+
+const char* color_format_name(const color_format_e color_format)
+{
+  switch (color_format) {
+    case color_format_e::rgba8:
+      return "RGBA8";
+    case color_format_e::rgb10a2:
+      return "RGB10A2";
+    case color_format_e::r11g11b10f:
+      return "R11G11B10F";
+    case color_format_e::rgba16f:
+      return "RGBA16F";
+    case color_format_e::rgba32f:
+    default:
+      return "RGBA32F";
+  }
+}
+
+int32_t color_format_bytes_per_pixel(const color_format_e color_format)
+{
+  switch (color_format) {
+    case color_format_e::rgba8:
+    case color_format_e::rgb10a2:
+    case color_format_e::r11g11b10f:
+      return 4;
+    case color_format_e::rgba16f:
+      return 8;
+    case color_format_e::rgba32f:
+    default:
+      return 16;
+  }
+}
+
+uint32_t depth_format_internal_format(const depth_format_e depth_format)
+{
+  switch (depth_format) {
+    case depth_format_e::d16:
+      return GL_DEPTH_COMPONENT16;
+    case depth_format_e::d24:
+      return GL_DEPTH_COMPONENT24;
+    case depth_format_e::d24s8:
+      return GL_DEPTH24_STENCIL8;
+    case depth_format_e::d32f:
+      return GL_DEPTH_COMPONENT32F;
+    case depth_format_e::d32fs8:
+    default:
+      return GL_DEPTH32F_STENCIL8;
+  }
+}
+
+const char* depth_format_name(const depth_format_e depth_format)
+{
+  switch (depth_format) {
+    case depth_format_e::d16:
+      return "D16";
+    case depth_format_e::d24:
+      return "D24";
+    case depth_format_e::d24s8:
+      return "D24S8";
+    case depth_format_e::d32f:
+      return "D32F";
+    case depth_format_e::d32fs8:
+    default:
+      return "D32FS8";
+  }
+}
+
+int32_t depth_format_bytes_per_pixel(const depth_format_e depth_format)
+{
+  switch (depth_format) {
+    case depth_format_e::d16:
+      return 2;
+    case depth_format_e::d24:
+    case depth_format_e::d24s8:
+    case depth_format_e::d32f:
+      return 4;
+    case depth_format_e::d32fs8:
+    default:
+      return 8;
+  }
+}
+
+bool depth_format_has_stencil(const depth_format_e depth_format)
+{
+  return depth_format == depth_format_e::d24s8
+      || depth_format == depth_format_e::d32fs8;
+}
+
+scene_targets_t create_scene_targets(
+  texture_pool_t& texture_pool, const int32_t width, const int32_t height,
+  const color_format_e color_format, const depth_format_e depth_format)
+{
+  scene_targets_t scene_targets;
+  scene_targets.width = width;
+  scene_targets.height = height;
+  scene_targets.render_width = width;
+  scene_targets.render_height = height;
+  scene_targets.color_format = color_format;
+  scene_targets.depth_format = depth_format;
+
+  scene_targets.color_texture = acquire_texture(
+    texture_pool, color_format_internal_format(color_format), width, height);
+  scene_targets.depth_texture = acquire_texture(
+    texture_pool, depth_format_internal_format(depth_format), width, height);
+
+  glGenFramebuffers(1, &scene_targets.framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, scene_targets.framebuffer);
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+    scene_targets.color_texture, 0);
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER,
+    depth_format_has_stencil(depth_format) ? GL_DEPTH_STENCIL_ATTACHMENT
+                                           : GL_DEPTH_ATTACHMENT,
+    GL_TEXTURE_2D, scene_targets.depth_texture, 0);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!\n";
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  return scene_targets;
+}
+
+void destroy_scene_targets(
+  texture_pool_t& texture_pool, scene_targets_t& scene_targets)
+{
+  glDeleteFramebuffers(1, &scene_targets.framebuffer);
+  release_texture(texture_pool, scene_targets.color_texture);
+  release_texture(texture_pool, scene_targets.depth_texture);
+  scene_targets = scene_targets_t{};
+}
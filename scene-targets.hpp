@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+struct texture_pool_t;
+
+enum class color_format_e
+{
+  rgba8,
+  rgb10a2,
+  r11g11b10f,
+  rgba16f,
+  rgba32f,
+  count
+};
+
+enum class depth_format_e
+{
+  d16,
+  d24,
+  d24s8,
+  d32f,
+  d32fs8,
+  count
+};
+
+uint32_t color_format_internal_format(color_format_e color_format);
+const char* color_format_name(color_format_e color_format);
+int32_t color_format_bytes_per_pixel(color_format_e color_format);
+
+uint32_t depth_format_internal_format(depth_format_e depth_format);
+const char* depth_format_name(depth_format_e depth_format);
+// what drivers commonly allocate, d24 is padded to 4 bytes and d32fs8 to 8
+int32_t depth_format_bytes_per_pixel(depth_format_e depth_format);
+bool depth_format_has_stencil(depth_format_e depth_format);
+
+// offscreen color and depth (plus stencil for d24s8/d32fs8) attachments the
+// scene is rendered into before being presented
+struct scene_targets_t
+{
+  uint32_t framebuffer = 0;
+  uint32_t color_texture = 0;
+  uint32_t depth_texture = 0;
+  int32_t width = 0;
+  int32_t height = 0;
+  // area (from the origin) the scene is rendered to, less than the full
+  // size when rendering at a reduced resolution
+  int32_t render_width = 0;
+  int32_t render_height = 0;
+  color_format_e color_format = color_format_e::rgba32f;
+  depth_format_e depth_format = depth_format_e::d32fs8;
+};
+
+// the textures come from (and go back to) texture_pool, the framebuffer is
+// cheap and created each time
+scene_targets_t create_scene_targets(
+  texture_pool_t& texture_pool, int32_t width, int32_t height,
+  color_format_e color_format, depth_format_e depth_format);
+void destroy_scene_targets(
+  texture_pool_t& texture_pool, scene_targets_t& scene_targets);
@@ -0,0 +1,207 @@
+#include "shader.hpp"
+
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+static uint64_t g_string_lookup_count = 0;
+
+static std::string resource_name(
+  const uint32_t program, const GLenum interface, const uint32_t index,
+  const int32_t name_length)
+{
+  std::string name(std::max(name_length, 1), '\0');
+  glGetProgramResourceName(
+    program, interface, index, name_length, nullptr, name.data());
+  name.resize(name_length > 0 ? name_length - 1 : 0); // drop null terminator
+  if (const size_t array = name.rfind("[0]");
+      array != std::string::npos && array + 3 == name.size()) {
+    name.resize(array);
+  }
+  return name;
+}
+
+static void reflect_program(shader_program_t& shader_program)
+{
+  const uint32_t program = shader_program.id;
+
+  int32_t uniform_count = 0;
+  glGetProgramInterfaceiv(
+    program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+  for (int32_t i = 0; i < uniform_count; ++i) {
+    const GLenum properties[] = {
+      GL_NAME_LENGTH, GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
+    int32_t values[std::size(properties)];
+    glGetProgramResourceiv(
+      program, GL_UNIFORM, i, std::size(properties), properties,
+      std::size(values), nullptr, values);
+    // members of uniform blocks have no location
+    if (values[4] != -1) {
+      continue;
+    }
+    shader_program.uniforms.push_back(shader_uniform_t{
+      resource_name(program, GL_UNIFORM, i, values[0]), values[3],
+      static_cast<uint32_t>(values[1]), values[2]});
+  }
+
+  int32_t uniform_block_count = 0;
+  glGetProgramInterfaceiv(
+    program, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &uniform_block_count);
+  for (int32_t i = 0; i < uniform_block_count; ++i) {
+    const GLenum properties[] = {
+      GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+    int32_t values[std::size(properties)];
+    glGetProgramResourceiv(
+      program, GL_UNIFORM_BLOCK, i, std::size(properties), properties,
+      std::size(values), nullptr, values);
+    shader_program.uniform_blocks.push_back(shader_uniform_block_t{
+      resource_name(program, GL_UNIFORM_BLOCK, i, values[0]),
+      static_cast<uint32_t>(i), values[1], values[2]});
+  }
+
+  int32_t attribute_count = 0;
+  glGetProgramInterfaceiv(
+    program, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &attribute_count);
+  for (int32_t i = 0; i < attribute_count; ++i) {
+    const GLenum properties[] = {
+      GL_NAME_LENGTH, GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION};
+    int32_t values[std::size(properties)];
+    glGetProgramResourceiv(
+      program, GL_PROGRAM_INPUT, i, std::size(properties), properties,
+      std::size(values), nullptr, values);
+    shader_program.attributes.push_back(shader_attribute_t{
+      resource_name(program, GL_PROGRAM_INPUT, i, values[0]), values[3],
+      static_cast<uint32_t>(values[1]), values[2]});
+  }
+}
+
+static shader_program_t link_program(
+  const uint32_t* shaders, const int shader_count)
+{
+  constexpr int info_log_size = 512;
+  char info_log[info_log_size];
+  info_log[0] = '\0';
+
+  shader_program_t shader_program;
+  shader_program.id = glCreateProgram();
+  for (int i = 0; i < shader_count; ++i) {
+    glAttachShader(shader_program.id, shaders[i]);
+  }
+  glLinkProgram(shader_program.id);
+  int shader_program_success;
+  glGetProgramiv(shader_program.id, GL_LINK_STATUS, &shader_program_success);
+  if (!shader_program_success) {
+    glGetProgramInfoLog(shader_program.id, info_log_size, NULL, info_log);
+    std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << info_log << '\0';
+  } else {
+    reflect_program(shader_program);
+  }
+
+  for (int i = 0; i < shader_count; ++i) {
+    glDeleteShader(shaders[i]);
+  }
+
+  return shader_program;
+}
+
+shader_program_t create_shader(
+  const char* vertex_shader_source, const char* fragment_shader_source)
+{
+  constexpr int info_log_size = 512;
+  char info_log[info_log_size];
+  info_log[0] = '\0';
+
+  uint32_t vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+  glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+  glCompileShader(vertex_shader);
+  int vertex_shader_success;
+  glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &vertex_shader_success);
+  if (!vertex_shader_success) {
+    glGetShaderInfoLog(vertex_shader, info_log_size, NULL, info_log);
+    std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
+              << info_log << '\0';
+  }
+
+  uint32_t fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+  glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+  glCompileShader(fragment_shader);
+  int fragment_shader_success;
+  glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &fragment_shader_success);
+  if (!fragment_shader_success) {
+    glGetShaderInfoLog(fragment_shader, info_log_size, NULL, info_log);
+    std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n"
+              << info_log << '\0';
+  }
+
+  const uint32_t shaders[] = {vertex_shader, fragment_shader};
+  return link_program(shaders, std::size(shaders));
+}
+
+shader_program_t create_compute_shader(const char* compute_shader_source)
+{
+  constexpr int info_log_size = 512;
+  char info_log[info_log_size];
+  info_log[0] = '\0';
+
+  uint32_t compute_shader = glCreateShader(GL_COMPUTE_SHADER);
+  glShaderSource(compute_shader, 1, &compute_shader_source, NULL);
+  glCompileShader(compute_shader);
+  int compute_shader_success;
+  glGetShaderiv(compute_shader, GL_COMPILE_STATUS, &compute_shader_success);
+  if (!compute_shader_success) {
+    glGetShaderInfoLog(compute_shader, info_log_size, NULL, info_log);
+    std::cout << "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n"
+              << info_log << '\0';
+  }
+
+  return link_program(&compute_shader, 1);
+}
+
+void destroy_shader(shader_program_t& shader_program)
+{
+  gl_state_delete_program(shader_program.id);
+  shader_program = shader_program_t{};
+}
+
+template<typename T>
+static const T* find_by_name(const std::vector<T>& resources, const char* name)
+{
+  g_string_lookup_count++;
+  const auto it = std::find_if(
+    resources.begin(), resources.end(),
+    [name](const T& resource) { return resource.name == name; });
+  return it != resources.end() ? &*it : nullptr;
+}
+
+int32_t shader_uniform_location(
+  const shader_program_t& shader_program, const char* name)
+{
+  const shader_uniform_t* uniform =
+    find_by_name(shader_program.uniforms, name);
+  return uniform != nullptr ? uniform->location : -1;
+}
+
+int32_t shader_uniform_block_index(
+  const shader_program_t& shader_program, const char* name)
+{
+  const shader_uniform_block_t* uniform_block =
+    find_by_name(shader_program.uniform_blocks, name);
+  return uniform_block != nullptr ? int32_t(uniform_block->index) : -1;
+}
+
+int32_t shader_attribute_location(
+  const shader_program_t& shader_program, const char* name)
+{
+  const shader_attribute_t* attribute =
+    find_by_name(shader_program.attributes, name);
+  return attribute != nullptr ? attribute->location : -1;
+}
+
+uint64_t shader_string_lookup_count()
+{
+  return g_string_lookup_count;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// array uniforms are stored without the trailing [0] (location is of the
+// first element, element i is at location + i)
+struct shader_uniform_t
+{
+  std::string name;
+  int32_t location = -1;
+  uint32_t type = 0;
+  int32_t size = 0;
+};
+
+struct shader_uniform_block_t
+{
+  std::string name;
+  uint32_t index = 0;
+  int32_t binding = 0;
+  int32_t data_size = 0;
+};
+
+struct shader_attribute_t
+{
+  std::string name;
+  int32_t location = -1;
+  uint32_t type = 0;
+  int32_t size = 0;
+};
+
+// a linked program with its active uniforms (default block only), uniform
+// blocks and vertex attributes reflected once at link time, names are
+// resolved to locations up front so nothing is looked up by string per frame
+struct shader_program_t
+{
+  uint32_t id = 0;
+  std::vector<shader_uniform_t> uniforms;
+  std::vector<shader_uniform_block_t> uniform_blocks;
+  std::vector<shader_attribute_t> attributes;
+};
+
+shader_program_t create_shader(
+  const char* vertex_shader_source, const char* fragment_shader_source);
+shader_program_t create_compute_shader(const char* compute_shader_source);
+void destroy_shader(shader_program_t& shader_program);
+
+// search the reflected data (no driver calls), -1 when not found or inactive
+// intended for setup, every call counts as a string lookup
+int32_t shader_uniform_location(
+  const shader_program_t& shader_program, const char* name);
+int32_t shader_uniform_block_index(
+  const shader_program_t& shader_program, const char* name);
+int32_t shader_attribute_location(
+  const shader_program_t& shader_program, const char* name);
+
+// total lookups by name so far, sample it each frame to confirm none happen
+// in the steady state
+uint64_t shader_string_lookup_count();
@@ -0,0 +1,140 @@
+#include "streaming-buffer.hpp"
+
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <chrono>
+
+static int64_t align_up(const int64_t value, const int64_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+static void allocate_storage(streaming_buffer_t& streaming_buffer)
+{
+  const int64_t size =
+    streaming_buffer.region_size * streaming_buffer.region_count;
+  const GLbitfield flags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glGenBuffers(1, &streaming_buffer.buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, streaming_buffer.buffer);
+  glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+  streaming_buffer.mapped = static_cast<uint8_t*>(
+    glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+static void release_storage(streaming_buffer_t& streaming_buffer)
+{
+  glBindBuffer(GL_COPY_WRITE_BUFFER, streaming_buffer.buffer);
+  glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  gl_state_delete_buffers(1, &streaming_buffer.buffer);
+  streaming_buffer.buffer = 0;
+  streaming_buffer.mapped = nullptr;
+}
+
+// returns the time spent blocked in seconds (0 if the fence had signaled)
+static float wait_fence(void*& fence)
+{
+  if (fence == nullptr) {
+    return 0.0f;
+  }
+  const auto sync = static_cast<GLsync>(fence);
+  float wait_time = 0.0f;
+  if (glClientWaitSync(sync, 0, 0) == GL_TIMEOUT_EXPIRED) {
+    const auto begin = std::chrono::steady_clock::now();
+    // flush so the fence is guaranteed to signal eventually
+    while (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000)
+           == GL_TIMEOUT_EXPIRED) {
+    }
+    wait_time = std::chrono::duration<float>(
+                  std::chrono::steady_clock::now() - begin)
+                  .count();
+  }
+  glDeleteSync(sync);
+  fence = nullptr;
+  return wait_time;
+}
+
+streaming_buffer_t create_streaming_buffer(
+  const int64_t region_size, const int32_t region_count)
+{
+  streaming_buffer_t streaming_buffer;
+  glGetIntegerv(
+    GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &streaming_buffer.alignment);
+  streaming_buffer.region_size =
+    align_up(region_size, streaming_buffer.alignment);
+  streaming_buffer.region_count = region_count;
+  streaming_buffer.fences.resize(region_count, nullptr);
+  allocate_storage(streaming_buffer);
+  return streaming_buffer;
+}
+
+void destroy_streaming_buffer(streaming_buffer_t& streaming_buffer)
+{
+  for (void*& fence : streaming_buffer.fences) {
+    wait_fence(fence);
+  }
+  release_storage(streaming_buffer);
+  streaming_buffer = streaming_buffer_t{};
+}
+
+void begin_streaming_buffer_frame(streaming_buffer_t& streaming_buffer)
+{
+  streaming_buffer.wait_time =
+    wait_fence(streaming_buffer.fences[streaming_buffer.region]);
+  if (streaming_buffer.wait_time > 0.0f) {
+    streaming_buffer.stall_count++;
+    streaming_buffer.total_wait_time += streaming_buffer.wait_time;
+  }
+  streaming_buffer.offset = 0;
+}
+
+void end_streaming_buffer_frame(streaming_buffer_t& streaming_buffer)
+{
+  streaming_buffer.fences[streaming_buffer.region] =
+    glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  streaming_buffer.region =
+    (streaming_buffer.region + 1) % streaming_buffer.region_count;
+}
+
+void reserve_streaming_buffer(
+  streaming_buffer_t& streaming_buffer, const int64_t region_size)
+{
+  if (region_size <= streaming_buffer.region_size) {
+    return;
+  }
+
+  for (void*& fence : streaming_buffer.fences) {
+    wait_fence(fence);
+  }
+  release_storage(streaming_buffer);
+
+  // grow geometrically to avoid draining the gpu every frame while growing
+  streaming_buffer.region_size = align_up(
+    std::max(region_size, streaming_buffer.region_size * 2),
+    streaming_buffer.alignment);
+  streaming_buffer.offset = 0;
+  streaming_buffer.resize_count++;
+  allocate_storage(streaming_buffer);
+}
+
+streaming_allocation_t allocate_streaming_buffer(
+  streaming_buffer_t& streaming_buffer, const int64_t size)
+{
+  const int64_t offset =
+    align_up(streaming_buffer.offset, streaming_buffer.alignment);
+  if (offset + size > streaming_buffer.region_size) {
+    return {};
+  }
+  streaming_buffer.offset = offset + size;
+
+  const int64_t buffer_offset =
+    streaming_buffer.region * streaming_buffer.region_size + offset;
+  return streaming_allocation_t{
+    streaming_buffer.mapped + buffer_offset, buffer_offset};
+}
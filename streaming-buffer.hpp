@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// a persistently mapped (coherent) buffer split into one region per frame in
+// flight, the cpu writes the current region directly while the gpu reads
+// the previous ones, each region is fenced at the end of the frame that
+// wrote it and waited on before it is written again
+struct streaming_buffer_t
+{
+  uint32_t buffer = 0;
+  uint8_t* mapped = nullptr;
+  int64_t region_size = 0;
+  int32_t region_count = 0;
+  int32_t region = 0;
+  int64_t offset = 0; // next free byte in the current region
+  int32_t alignment = 1; // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+  std::vector<void*> fences; // GLsync per region, null when not in use
+  // frames that had to wait for the gpu before writing their region
+  int32_t stall_count = 0;
+  float wait_time = 0.0f; // seconds waited this frame
+  float total_wait_time = 0.0f;
+  int32_t resize_count = 0;
+};
+
+// where an allocation lives, data is written by the cpu and offset is used
+// to bind the range (e.g. with glBindBufferRange)
+struct streaming_allocation_t
+{
+  void* data = nullptr;
+  int64_t offset = 0;
+};
+
+streaming_buffer_t create_streaming_buffer(
+  int64_t region_size, int32_t region_count);
+void destroy_streaming_buffer(streaming_buffer_t& streaming_buffer);
+
+// moves to the next region, waiting (and recording the stall) if the gpu is
+// still reading from it
+void begin_streaming_buffer_frame(streaming_buffer_t& streaming_buffer);
+// fences the current region once every command reading from it is issued
+void end_streaming_buffer_frame(streaming_buffer_t& streaming_buffer);
+
+// grows the regions so a frame can allocate at least region_size bytes, this
+// drains the gpu so call before anything is written for the frame
+void reserve_streaming_buffer(
+  streaming_buffer_t& streaming_buffer, int64_t region_size);
+
+// space for size bytes in the current region (offset is suitably aligned
+// for binding as a uniform buffer range), data is null if the region is full
+streaming_allocation_t allocate_streaming_buffer(
+  streaming_buffer_t& streaming_buffer, int64_t size);
@@ -0,0 +1,76 @@
+#include "texture-pool.hpp"
+
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+
+#include <algorithm>
+
+void destroy_texture_pool(texture_pool_t& texture_pool)
+{
+  for (const pooled_texture_t& pooled : texture_pool.textures) {
+    gl_state_delete_textures(1, &pooled.texture);
+  }
+  texture_pool = texture_pool_t{};
+}
+
+uint32_t acquire_texture(
+  texture_pool_t& texture_pool, const uint32_t internal_format,
+  const int32_t width, const int32_t height)
+{
+  for (pooled_texture_t& pooled : texture_pool.textures) {
+    if (
+      !pooled.in_use && pooled.internal_format == internal_format
+      && pooled.width == width && pooled.height == height) {
+      pooled.in_use = true;
+      texture_pool.hit_count++;
+      return pooled.texture;
+    }
+  }
+
+  pooled_texture_t pooled;
+  pooled.internal_format = internal_format;
+  pooled.width = width;
+  pooled.height = height;
+  pooled.in_use = true;
+  glGenTextures(1, &pooled.texture);
+  gl_state_bind_texture(GL_TEXTURE_2D, pooled.texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, internal_format, width, height);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+  texture_pool.textures.push_back(pooled);
+  texture_pool.miss_count++;
+  return pooled.texture;
+}
+
+void release_texture(texture_pool_t& texture_pool, const uint32_t texture)
+{
+  const auto pooled = std::find_if(
+    texture_pool.textures.begin(), texture_pool.textures.end(),
+    [texture](const pooled_texture_t& pooled) {
+      return pooled.texture == texture;
+    });
+  if (pooled != texture_pool.textures.end()) {
+    pooled->in_use = false;
+    pooled->release_frame = texture_pool.frame;
+  }
+}
+
+void trim_texture_pool(texture_pool_t& texture_pool)
+{
+  texture_pool.frame++;
+  const auto idle = [&texture_pool](const pooled_texture_t& pooled) {
+    return !pooled.in_use
+        && texture_pool.frame - pooled.release_frame
+             > uint64_t(texture_pool.max_idle_frames);
+  };
+  for (const pooled_texture_t& pooled : texture_pool.textures) {
+    if (idle(pooled)) {
+      gl_state_delete_textures(1, &pooled.texture);
+      texture_pool.evict_count++;
+    }
+  }
+  texture_pool.textures.erase(
+    std::remove_if(
+      texture_pool.textures.begin(), texture_pool.textures.end(), idle),
+    texture_pool.textures.end());
+}
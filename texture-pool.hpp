@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// immutable 2d textures (one level) kept by internal format and size so
+// render targets that are reallocated (e.g. while resizing or switching
+// formats) reuse storage that's already there instead of allocating again,
+// released textures stay pooled until they've been idle for max_idle_frames
+struct pooled_texture_t
+{
+  uint32_t texture = 0;
+  uint32_t internal_format = 0;
+  int32_t width = 0;
+  int32_t height = 0;
+  bool in_use = false;
+  uint64_t release_frame = 0;
+};
+
+struct texture_pool_t
+{
+  std::vector<pooled_texture_t> textures;
+  uint64_t frame = 0;
+  int32_t max_idle_frames = 120;
+  int64_t hit_count = 0; // acquires served from the pool
+  int64_t miss_count = 0; // acquires that had to allocate
+  int64_t evict_count = 0;
+};
+
+void destroy_texture_pool(texture_pool_t& texture_pool);
+
+uint32_t acquire_texture(
+  texture_pool_t& texture_pool, uint32_t internal_format, int32_t width,
+  int32_t height);
+// the texture goes back to the pool, it must have come from acquire_texture
+void release_texture(texture_pool_t& texture_pool, uint32_t texture);
+
+// call once a frame, deletes textures idle for longer than max_idle_frames
+void trim_texture_pool(texture_pool_t& texture_pool);
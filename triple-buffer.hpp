@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// hands the latest value from one writer thread to one reader thread without
+// locking, each side owns a slot and the third is exchanged between them, the
+// writer never waits and the reader skips values it didn't get to in time
+template<typename T>
+struct triple_buffer_t
+{
+  T slots[3] = {};
+  // slot between the writer and reader, with g_triple_buffer_fresh set when
+  // it holds a value the reader hasn't taken yet
+  std::atomic<uint8_t> middle = 1;
+  uint8_t back = 0; // writer only
+  uint8_t front = 2; // reader only
+};
+
+constexpr uint8_t g_triple_buffer_index_mask = 0x3;
+constexpr uint8_t g_triple_buffer_fresh = 0x4;
+
+// the slot to write the next value into, complete it then publish it
+template<typename T>
+T& triple_buffer_back(triple_buffer_t<T>& triple_buffer)
+{
+  return triple_buffer.slots[triple_buffer.back];
+}
+
+template<typename T>
+void publish_triple_buffer(triple_buffer_t<T>& triple_buffer)
+{
+  // release the written slot, acquire whatever the reader left behind
+  triple_buffer.back =
+    triple_buffer.middle.exchange(
+      triple_buffer.back | g_triple_buffer_fresh, std::memory_order_acq_rel)
+    & g_triple_buffer_index_mask;
+}
+
+// moves the newest published value to the front, returns false (leaving the
+// front as it was) when nothing was published since the last call
+template<typename T>
+bool acquire_triple_buffer(triple_buffer_t<T>& triple_buffer)
+{
+  if (
+    (triple_buffer.middle.load(std::memory_order_relaxed)
+     & g_triple_buffer_fresh)
+    == 0) {
+    return false;
+  }
+  triple_buffer.front =
+    triple_buffer.middle.exchange(
+      triple_buffer.front, std::memory_order_acq_rel)
+    & g_triple_buffer_index_mask;
+  return true;
+}
+
+template<typename T>
+const T& triple_buffer_front(const triple_buffer_t<T>& triple_buffer)
+{
+  return triple_buffer.slots[triple_buffer.front];
+}
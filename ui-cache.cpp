@@ -0,0 +1,215 @@
+#include "ui-cache.hpp"
+
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+#include <imgui.h>
+
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <cstring>
+#include <iostream>
+
+const char* const g_ui_composite_vertex_shader_source =
+  R"(#version 460 core
+void main()
+{
+  // one triangle covering the screen
+  const vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+  gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+})";
+
+const char* const g_ui_composite_fragment_shader_source =
+  R"(#version 460 core
+out vec4 FragColor;
+uniform sampler2D ui;
+void main()
+{
+  // premultiplied, see render_ui_cached
+  FragColor = texelFetch(ui, ivec2(gl_FragCoord.xy), 0);
+})";
+
+constexpr uint64_t g_fnv_offset_basis = 14695981039346656037ull;
+constexpr uint64_t g_fnv_prime = 1099511628211ull;
+
+// fnv-1a over 8 byte words (bytes for the tail) with an extra fold of the
+// high bits, not the canonical byte wise fnv but an eighth of the multiplies
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size)
+{
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(uint64_t));
+    bytes += sizeof(uint64_t);
+    hash = (hash ^ word) * g_fnv_prime;
+    hash ^= hash >> 32;
+  }
+  for (; size > 0; --size) {
+    hash = (hash ^ *bytes++) * g_fnv_prime;
+  }
+  return hash;
+}
+
+template<typename T>
+static uint64_t hash_value(const uint64_t hash, const T& value)
+{
+  return hash_bytes(hash, &value, sizeof(T));
+}
+
+uint64_t hash_draw_data(const ImDrawData* draw_data)
+{
+  uint64_t hash = g_fnv_offset_basis;
+  hash = hash_value(hash, draw_data->DisplayPos);
+  hash = hash_value(hash, draw_data->DisplaySize);
+  hash = hash_value(hash, draw_data->FramebufferScale);
+  hash = hash_value(hash, draw_data->CmdListsCount);
+  for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+    const ImDrawList* cmd_list = draw_data->CmdLists[n];
+    hash = hash_bytes(
+      hash, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.size_in_bytes());
+    hash = hash_bytes(
+      hash, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.size_in_bytes());
+    // field by field, ImDrawCmd has padding and user data
+    for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+      hash = hash_value(hash, cmd.ClipRect);
+      hash = hash_value(hash, cmd.GetTexID());
+      hash = hash_value(hash, cmd.VtxOffset);
+      hash = hash_value(hash, cmd.IdxOffset);
+      hash = hash_value(hash, cmd.ElemCount);
+    }
+  }
+  return hash;
+}
+
+static bool has_user_callbacks(const ImDrawData* draw_data)
+{
+  for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+    for (const ImDrawCmd& cmd : draw_data->CmdLists[n]->CmdBuffer) {
+      if (cmd.UserCallback != nullptr) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void release_target(ui_cache_t& ui_cache)
+{
+  glDeleteFramebuffers(1, &ui_cache.framebuffer);
+  gl_state_delete_textures(1, &ui_cache.texture);
+  ui_cache.framebuffer = 0;
+  ui_cache.texture = 0;
+  ui_cache.valid = false;
+}
+
+static void allocate_target(
+  ui_cache_t& ui_cache, const int32_t width, const int32_t height)
+{
+  release_target(ui_cache);
+  ui_cache.width = width;
+  ui_cache.height = height;
+
+  glGenTextures(1, &ui_cache.texture);
+  gl_state_bind_texture(GL_TEXTURE_2D, ui_cache.texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &ui_cache.framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, ui_cache.framebuffer);
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ui_cache.texture, 0);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    std::cout << "ERROR::FRAMEBUFFER:: UI cache framebuffer is not complete!\n";
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+ui_cache_t create_ui_cache()
+{
+  ui_cache_t ui_cache;
+  ui_cache.composite_program = create_shader(
+    g_ui_composite_vertex_shader_source,
+    g_ui_composite_fragment_shader_source);
+  glGenVertexArrays(1, &ui_cache.vertex_array);
+  return ui_cache;
+}
+
+void destroy_ui_cache(ui_cache_t& ui_cache)
+{
+  release_target(ui_cache);
+  gl_state_delete_vertex_arrays(1, &ui_cache.vertex_array);
+  destroy_shader(ui_cache.composite_program);
+  ui_cache = ui_cache_t{};
+}
+
+static void composite_ui(const ui_cache_t& ui_cache)
+{
+  const bool blend = gl_state_is_enabled(GL_BLEND);
+  int32_t blend_func[4];
+  gl_state_get_integerv(GL_BLEND_SRC_RGB, &blend_func[0]);
+  gl_state_get_integerv(GL_BLEND_DST_RGB, &blend_func[1]);
+  gl_state_get_integerv(GL_BLEND_SRC_ALPHA, &blend_func[2]);
+  gl_state_get_integerv(GL_BLEND_DST_ALPHA, &blend_func[3]);
+
+  gl_state_disable(GL_DEPTH_TEST);
+  gl_state_disable(GL_SCISSOR_TEST);
+  gl_state_enable(GL_BLEND);
+  gl_state_blend_equation(GL_FUNC_ADD);
+  gl_state_blend_func_separate(
+    GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  gl_state_viewport(0, 0, ui_cache.width, ui_cache.height);
+  gl_state_use_program(ui_cache.composite_program.id);
+  gl_state_active_texture(GL_TEXTURE0);
+  gl_state_bind_texture(GL_TEXTURE_2D, ui_cache.texture);
+  gl_state_bind_vertex_array(ui_cache.vertex_array);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+
+  gl_state_blend_func_separate(
+    blend_func[0], blend_func[1], blend_func[2], blend_func[3]);
+  if (!blend) {
+    gl_state_disable(GL_BLEND);
+  }
+}
+
+void render_ui_cached(ui_cache_t& ui_cache, ImDrawData* draw_data)
+{
+  const ImVec2 size = draw_data->DisplaySize;
+  const ImVec2 scale = draw_data->FramebufferScale;
+  const auto width = static_cast<int32_t>(size.x * scale.x);
+  const auto height = static_cast<int32_t>(size.y * scale.y);
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  ui_cache.hit = false;
+  if (has_user_callbacks(draw_data)) {
+    ui_cache.valid = false;
+    ui_cache.miss_count++;
+    ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    return;
+  }
+
+  if (width != ui_cache.width || height != ui_cache.height) {
+    allocate_target(ui_cache, width, height);
+  }
+
+  const uint64_t hash = hash_draw_data(draw_data);
+  ui_cache.hit = ui_cache.valid && hash == ui_cache.hash;
+  if (ui_cache.hit) {
+    ui_cache.hit_count++;
+  } else {
+    ui_cache.miss_count++;
+    // imgui blends color with src alpha and alpha with one, over a
+    // transparent target this leaves premultiplied color and coverage
+    glBindFramebuffer(GL_FRAMEBUFFER, ui_cache.framebuffer);
+    gl_state_disable(GL_SCISSOR_TEST);
+    const float transparent[] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, transparent);
+    ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ui_cache.hash = hash;
+    ui_cache.valid = true;
+  }
+
+  composite_ui(ui_cache);
+}
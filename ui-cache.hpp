@@ -0,0 +1,36 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <cstdint>
+
+struct ImDrawData;
+
+// retained ui, the imgui draw data is hashed every frame and only rendered
+// (into an offscreen rgba8 texture) when it changed, the texture is then
+// composited over the default framebuffer with premultiplied alpha
+struct ui_cache_t
+{
+  shader_program_t composite_program;
+  uint32_t vertex_array = 0; // empty, the composite triangle has no inputs
+  uint32_t framebuffer = 0;
+  uint32_t texture = 0;
+  int32_t width = 0;
+  int32_t height = 0;
+  uint64_t hash = 0; // of the draw data in texture
+  bool valid = false;
+  bool hit = false; // last frame was composited from the cache
+  uint64_t hit_count = 0;
+  uint64_t miss_count = 0;
+};
+
+ui_cache_t create_ui_cache();
+void destroy_ui_cache(ui_cache_t& ui_cache);
+
+// a hash of everything that affects how the draw data is rasterized
+uint64_t hash_draw_data(const ImDrawData* draw_data);
+
+// renders draw_data to the default framebuffer, through the cache when
+// possible, the texture follows the framebuffer size of the draw data
+// draw data with user callbacks can't be cached and is rendered directly
+void render_ui_cached(ui_cache_t& ui_cache, ImDrawData* draw_data);
@@ -0,0 +1,306 @@
+#include "z-fighting.hpp"
+
+#include "gl-state.hpp"
+
+#include <glad/gl.h>
+
+#include <iostream>
+#include <limits>
+
+// shared by every draw, invariant so each pass rasterizes identically
+const char* const g_z_fighting_vertex_shader_source =
+  R"(#version 460 core
+layout (location = 0) in vec3 aPos;
+struct instance_t
+{
+  mat4 model;
+  vec4 color;
+};
+layout (std430, binding = 0) readonly buffer instances
+{
+  instance_t instance_data[];
+};
+uniform mat4 view_projection;
+invariant gl_Position;
+flat out uint quad_id;
+void main()
+{
+  gl_Position =
+    view_projection * instance_data[gl_InstanceID].model * vec4(aPos, 1.0);
+  quad_id = uint(gl_InstanceID) + 1u;
+})";
+
+const char* const g_z_fighting_reference_depth_fragment_shader_source =
+  R"(#version 460 core
+layout (r32ui, binding = 0) uniform uimage2D reference_depth;
+void main()
+{
+  // 1/w is the view distance, the bits of positive floats order the same
+  // way as their values
+  imageAtomicMin(
+    reference_depth, ivec2(gl_FragCoord.xy),
+    floatBitsToUint(1.0 / gl_FragCoord.w));
+})";
+
+const char* const g_z_fighting_reference_id_fragment_shader_source =
+  R"(#version 460 core
+layout (r32ui, binding = 0) readonly uniform uimage2D reference_depth;
+layout (r32ui, binding = 1) writeonly uniform uimage2D reference_id;
+flat in uint quad_id;
+void main()
+{
+  const ivec2 texel = ivec2(gl_FragCoord.xy);
+  if (floatBitsToUint(1.0 / gl_FragCoord.w)
+      == imageLoad(reference_depth, texel).r) {
+    imageStore(reference_id, texel, uvec4(quad_id));
+  }
+})";
+
+const char* const g_z_fighting_depth_tested_fragment_shader_source =
+  R"(#version 460 core
+layout (location = 0) out uint id;
+flat in uint quad_id;
+void main()
+{
+  id = quad_id;
+})";
+
+const char* const g_z_fighting_count_compute_shader_source =
+  R"(#version 460 core
+layout (local_size_x = 8, local_size_y = 8) in;
+layout (r32ui, binding = 0) readonly uniform uimage2D depth_tested_id;
+layout (r32ui, binding = 1) readonly uniform uimage2D reference_id;
+layout (std430, binding = 0) buffer count
+{
+  uint fighting_count;
+};
+void main()
+{
+  const ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, imageSize(reference_id)))) {
+    return;
+  }
+  if (imageLoad(depth_tested_id, texel).r != imageLoad(reference_id, texel).r) {
+    atomicAdd(fighting_count, 1u);
+  }
+})";
+
+static uint32_t create_id_texture(const int32_t width, const int32_t height)
+{
+  uint32_t texture;
+  glGenTextures(1, &texture);
+  gl_state_bind_texture(GL_TEXTURE_2D, texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, width, height);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+  return texture;
+}
+
+// the depth attachment follows the format being measured
+static void attach_depth_texture(
+  z_fighting_t& z_fighting, const depth_format_e depth_format)
+{
+  gl_state_delete_textures(1, &z_fighting.depth_texture);
+  glGenTextures(1, &z_fighting.depth_texture);
+  gl_state_bind_texture(GL_TEXTURE_2D, z_fighting.depth_texture);
+  glTexStorage2D(
+    GL_TEXTURE_2D, 1, depth_format_internal_format(depth_format),
+    z_fighting.width, z_fighting.height);
+  gl_state_bind_texture(GL_TEXTURE_2D, 0);
+  z_fighting.depth_format = depth_format;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, z_fighting.framebuffer);
+  // replaces whichever of the two the previous format used
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER,
+    depth_format_has_stencil(depth_format) ? GL_DEPTH_STENCIL_ATTACHMENT
+                                           : GL_DEPTH_ATTACHMENT,
+    GL_TEXTURE_2D, z_fighting.depth_texture, 0);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    std::cout << "ERROR::FRAMEBUFFER:: Z-fighting framebuffer is not "
+                 "complete!\n";
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+static void release_targets(z_fighting_t& z_fighting)
+{
+  glDeleteFramebuffers(1, &z_fighting.framebuffer);
+  gl_state_delete_textures(1, &z_fighting.depth_tested_id_texture);
+  gl_state_delete_textures(1, &z_fighting.depth_texture);
+  gl_state_delete_textures(1, &z_fighting.reference_depth_texture);
+  gl_state_delete_textures(1, &z_fighting.reference_id_texture);
+  z_fighting.framebuffer = 0;
+  z_fighting.depth_tested_id_texture = 0;
+  z_fighting.depth_texture = 0;
+  z_fighting.reference_depth_texture = 0;
+  z_fighting.reference_id_texture = 0;
+  z_fighting.depth_format = depth_format_e::count;
+}
+
+// the depth texture is attached on first use, see attach_depth_texture
+static void allocate_targets(
+  z_fighting_t& z_fighting, const int32_t width, const int32_t height)
+{
+  z_fighting.width = width;
+  z_fighting.height = height;
+  z_fighting.depth_tested_id_texture = create_id_texture(width, height);
+  z_fighting.reference_depth_texture = create_id_texture(width, height);
+  z_fighting.reference_id_texture = create_id_texture(width, height);
+
+  glGenFramebuffers(1, &z_fighting.framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, z_fighting.framebuffer);
+  glFramebufferTexture2D(
+    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+    z_fighting.depth_tested_id_texture, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+z_fighting_t create_z_fighting(const int32_t width, const int32_t height)
+{
+  z_fighting_t z_fighting;
+
+  z_fighting.reference_depth_program = create_shader(
+    g_z_fighting_vertex_shader_source,
+    g_z_fighting_reference_depth_fragment_shader_source);
+  z_fighting.reference_id_program = create_shader(
+    g_z_fighting_vertex_shader_source,
+    g_z_fighting_reference_id_fragment_shader_source);
+  z_fighting.depth_tested_program = create_shader(
+    g_z_fighting_vertex_shader_source,
+    g_z_fighting_depth_tested_fragment_shader_source);
+  z_fighting.count_program =
+    create_compute_shader(g_z_fighting_count_compute_shader_source);
+  z_fighting.reference_depth_view_projection_loc = shader_uniform_location(
+    z_fighting.reference_depth_program, "view_projection");
+  z_fighting.reference_id_view_projection_loc = shader_uniform_location(
+    z_fighting.reference_id_program, "view_projection");
+  z_fighting.depth_tested_view_projection_loc = shader_uniform_location(
+    z_fighting.depth_tested_program, "view_projection");
+
+  allocate_targets(z_fighting, width, height);
+
+  glGenBuffers(1, &z_fighting.count_buffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, z_fighting.count_buffer);
+  glBufferData(
+    GL_SHADER_STORAGE_BUFFER, sizeof(uint32_t), nullptr, GL_DYNAMIC_READ);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  return z_fighting;
+}
+
+void destroy_z_fighting(z_fighting_t& z_fighting)
+{
+  gl_state_delete_buffers(1, &z_fighting.count_buffer);
+  release_targets(z_fighting);
+  destroy_shader(z_fighting.count_program);
+  destroy_shader(z_fighting.depth_tested_program);
+  destroy_shader(z_fighting.reference_id_program);
+  destroy_shader(z_fighting.reference_depth_program);
+  z_fighting = z_fighting_t{};
+}
+
+void resize_z_fighting(
+  z_fighting_t& z_fighting, const int32_t width, const int32_t height)
+{
+  if (width == z_fighting.width && height == z_fighting.height) {
+    return;
+  }
+  release_targets(z_fighting);
+  allocate_targets(z_fighting, width, height);
+}
+
+static void draw_quads(
+  const shader_program_t& program, const int32_t view_projection_loc,
+  const as::mat4& view_projection, const uint32_t vao,
+  const int32_t instance_count)
+{
+  gl_state_use_program(program.id);
+  glUniformMatrix4fv(
+    view_projection_loc, 1, GL_FALSE, as::mat_const_data(view_projection));
+  gl_state_bind_vertex_array(vao);
+  glDrawElementsInstanced(
+    GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, instance_count);
+}
+
+int32_t count_z_fighting_pixels(
+  z_fighting_t& z_fighting, const depth_format_e depth_format,
+  const bool reverse_z, const as::mat4& view_projection, const uint32_t vao,
+  const uint32_t instance_buffer, const int32_t instance_count)
+{
+  if (depth_format != z_fighting.depth_format) {
+    attach_depth_texture(z_fighting, depth_format);
+  }
+
+  const uint32_t far_bits = std::numeric_limits<uint32_t>::max();
+  const uint32_t empty = 0;
+  glClearTexImage(
+    z_fighting.reference_depth_texture, 0, GL_RED_INTEGER, GL_UNSIGNED_INT,
+    &far_bits);
+  glClearTexImage(
+    z_fighting.reference_id_texture, 0, GL_RED_INTEGER, GL_UNSIGNED_INT,
+    &empty);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, z_fighting.count_buffer);
+  glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(uint32_t), &empty);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, z_fighting.framebuffer);
+  gl_state_viewport(0, 0, z_fighting.width, z_fighting.height);
+  gl_state_disable(GL_BLEND);
+  gl_state_disable(GL_SCISSOR_TEST);
+  gl_state_disable(GL_CULL_FACE);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instance_buffer);
+
+  // reference, every fragment of every quad without a depth test
+  gl_state_disable(GL_DEPTH_TEST);
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  glBindImageTexture(
+    0, z_fighting.reference_depth_texture, 0, GL_FALSE, 0, GL_READ_WRITE,
+    GL_R32UI);
+  draw_quads(
+    z_fighting.reference_depth_program,
+    z_fighting.reference_depth_view_projection_loc, view_projection, vao,
+    instance_count);
+  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+  glBindImageTexture(
+    1, z_fighting.reference_id_texture, 0, GL_FALSE, 0, GL_WRITE_ONLY,
+    GL_R32UI);
+  draw_quads(
+    z_fighting.reference_id_program,
+    z_fighting.reference_id_view_projection_loc, view_projection, vao,
+    instance_count);
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+  // the depth format and test being measured
+  const uint32_t clear_id[] = {0, 0, 0, 0};
+  glClearBufferuiv(GL_COLOR, 0, clear_id);
+  const float clear_depth = reverse_z ? 0.0f : 1.0f;
+  glClearBufferfv(GL_DEPTH, 0, &clear_depth);
+  gl_state_enable(GL_DEPTH_TEST);
+  gl_state_depth_func(reverse_z ? GL_GREATER : GL_LESS);
+  draw_quads(
+    z_fighting.depth_tested_program,
+    z_fighting.depth_tested_view_projection_loc, view_projection, vao,
+    instance_count);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+  gl_state_use_program(z_fighting.count_program.id);
+  glBindImageTexture(
+    0, z_fighting.depth_tested_id_texture, 0, GL_FALSE, 0, GL_READ_ONLY,
+    GL_R32UI);
+  glBindImageTexture(
+    1, z_fighting.reference_id_texture, 0, GL_FALSE, 0, GL_READ_ONLY,
+    GL_R32UI);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, z_fighting.count_buffer);
+  glDispatchCompute((z_fighting.width + 7) / 8, (z_fighting.height + 7) / 8, 1);
+
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  uint32_t count = 0;
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, z_fighting.count_buffer);
+  glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(uint32_t), &count);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  return static_cast<int32_t>(count);
+}
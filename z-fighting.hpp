@@ -0,0 +1,45 @@
+#pragma once
+
+#include "scene-targets.hpp"
+#include "shader.hpp"
+
+#include <as/as-math-ops.hpp>
+
+#include <cstdint>
+
+// counts z-fighting pixels on the gpu, the quads are drawn with the depth
+// format and test being measured (recording which quad won each pixel) and
+// the nearest quad per pixel is found exactly from the view distance (1/w)
+// with image atomics, every pixel where the two disagree is fighting
+struct z_fighting_t
+{
+  shader_program_t reference_depth_program;
+  shader_program_t reference_id_program;
+  shader_program_t depth_tested_program;
+  shader_program_t count_program;
+  uint32_t framebuffer = 0;
+  uint32_t depth_tested_id_texture = 0; // r32ui, quad index + 1, 0 is empty
+  uint32_t depth_texture = 0;
+  uint32_t reference_depth_texture = 0; // r32ui, bits of the nearest 1/w
+  uint32_t reference_id_texture = 0; // r32ui, as depth_tested_id_texture
+  uint32_t count_buffer = 0;
+  int32_t reference_depth_view_projection_loc = -1;
+  int32_t reference_id_view_projection_loc = -1;
+  int32_t depth_tested_view_projection_loc = -1;
+  int32_t width = 0;
+  int32_t height = 0;
+  depth_format_e depth_format = depth_format_e::count; // of depth_texture
+};
+
+z_fighting_t create_z_fighting(int32_t width, int32_t height);
+void destroy_z_fighting(z_fighting_t& z_fighting);
+// keeps the programs, only the targets are reallocated
+void resize_z_fighting(z_fighting_t& z_fighting, int32_t width, int32_t height);
+
+// instance_buffer holds an array of quad_instance_t (see instanced-quads.hpp)
+// and vao is the quad vao, the count is read back straight away so this
+// stalls, meant to be run on demand rather than every frame
+int32_t count_z_fighting_pixels(
+  z_fighting_t& z_fighting, depth_format_e depth_format, bool reverse_z,
+  const as::mat4& view_projection, uint32_t vao, uint32_t instance_buffer,
+  int32_t instance_count);